@@ -0,0 +1,405 @@
+// Microbenchmarks for the hot paths of the bignum C++ kernels.
+//
+// Each benchmark is parameterised by vector size (1 to 10^7) and the number
+// of decimal digits per element (1 to 10^5). Combinations whose total input
+// exceeds `max_total_digits` are skipped to keep memory use reasonable.
+
+#include <climits>
+#include <random>
+#include <string>
+#include <benchmark/benchmark.h>
+#include "biginteger_vector.h"
+#include "biginteger_arena.h"
+#include "biginteger_text.h"
+#include "bigfloat_vector.h"
+#include "bigfloat_batch.h"
+#include "operations.h"
+#include "compare.h"
+#include "format.h"
+#include "fixed_width.h"
+#include "multiply.h"
+
+namespace {
+
+const long max_size = 10000000;
+const long max_digits = 100000;
+const long max_total_digits = 100000000;
+
+void size_digits_args(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"size", "digits"});
+  for (long size = 1; size <= max_size; size *= 10) {
+    for (long digits = 1; digits <= max_digits; digits *= 10) {
+      if (size * digits <= max_total_digits) {
+        b->Args({size, digits});
+      }
+    }
+  }
+}
+
+// Deterministic random integers with exactly `digits` digits (roughly half
+// negative), or decimals with the point placed in the middle.
+cpp11::strings random_strings(long size, long digits, bool decimal) {
+  std::mt19937_64 rng(20230504);
+  std::uniform_int_distribution<int> digit(0, 9);
+  std::uniform_int_distribution<int> leading(1, 9);
+  std::bernoulli_distribution negative(0.5);
+
+  cpp11::writable::strings output(size);
+  for (long i=0; i<size; ++i) {
+    std::string str;
+    if (negative(rng)) {
+      str.push_back('-');
+    }
+    str.push_back('0' + leading(rng));
+    for (long j=1; j<digits; ++j) {
+      if (decimal && j == (digits + 1) / 2) {
+        str.push_back('.');
+      }
+      str.push_back('0' + digit(rng));
+    }
+    output[i] = str;
+  }
+
+  return output;
+}
+
+// Deterministic random non-negative integer with `bits` bits
+biginteger_type random_integer(long bits) {
+  std::mt19937_64 rng(20230504);
+  const long limb_bits = sizeof(boost::multiprecision::limb_type) * CHAR_BIT;
+  const long n_limbs = (bits + limb_bits - 1) / limb_bits;
+
+  biginteger_type output;
+  output.backend().resize(n_limbs, n_limbs);
+  for (long k=0; k<n_limbs; ++k) {
+    output.backend().limbs()[k] = static_cast<boost::multiprecision::limb_type>(rng());
+  }
+  output.backend().normalize();
+
+  // Exactly `bits` bits
+  output >>= n_limbs * limb_bits - bits;
+  boost::multiprecision::bit_set(output, bits - 1);
+  return output;
+}
+
+// Single operands of 2^14 to 2^22 bits
+void large_bits_args(benchmark::internal::Benchmark *b) {
+  b->ArgName("bits")->RangeMultiplier(4)->Range(1 << 14, 1 << 22);
+}
+
+void set_counters(benchmark::State &state) {
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+}
+
+
+/*-----------*
+ *  Parsing  *
+ *-----------*/
+void BM_biginteger_parse(benchmark::State &state) {
+  cpp11::strings input = random_strings(state.range(0), state.range(1), false);
+
+  for (auto _ : state) {
+    biginteger_vector x(input);
+    benchmark::DoNotOptimize(x.data.data());
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_biginteger_parse)->Apply(size_digits_args);
+
+void BM_biginteger_parse_arena(benchmark::State &state) {
+  cpp11::strings input = random_strings(state.range(0), state.range(1), false);
+
+  for (auto _ : state) {
+    biginteger_arena x(input);
+    benchmark::DoNotOptimize(x.limbs.data());
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_biginteger_parse_arena)->Apply(size_digits_args);
+
+void BM_bigfloat_parse(benchmark::State &state) {
+  cpp11::strings input = random_strings(state.range(0), state.range(1), true);
+
+  for (auto _ : state) {
+    bigfloat_vector x(input);
+    benchmark::DoNotOptimize(x.data.data());
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_bigfloat_parse)->Apply(size_digits_args);
+
+
+/*--------------*
+ *  Formatting  *
+ *--------------*/
+void BM_biginteger_encode(benchmark::State &state) {
+  biginteger_vector x(random_strings(state.range(0), state.range(1), false));
+
+  for (auto _ : state) {
+    cpp11::strings output = format_biginteger_vector(x, bignum_format_dec);
+    benchmark::DoNotOptimize(output);
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_biginteger_encode)->Apply(size_digits_args);
+
+void BM_format_bigfloat(benchmark::State &state, bignum_format_notation notation) {
+  bigfloat_vector x(random_strings(state.range(0), state.range(1), true));
+  const int digits = std::numeric_limits<bigfloat_type>::max_digits10;
+
+  for (auto _ : state) {
+    for (std::size_t i=0; i<x.size(); ++i) {
+      std::string output = format_bigfloat(x.data[i], notation, digits, true);
+      benchmark::DoNotOptimize(output);
+    }
+  }
+
+  set_counters(state);
+}
+BENCHMARK_CAPTURE(BM_format_bigfloat, dec, bignum_format_dec)->Apply(size_digits_args);
+BENCHMARK_CAPTURE(BM_format_bigfloat, sci, bignum_format_sci)->Apply(size_digits_args);
+
+
+/*--------------*
+ *  Arithmetic  *
+ *--------------*/
+void BM_biginteger_add(benchmark::State &state) {
+  biginteger_vector lhs(random_strings(state.range(0), state.range(1), false));
+  biginteger_vector rhs(random_strings(state.range(0), state.range(1), false));
+
+  for (auto _ : state) {
+    biginteger_vector output = binary_operation_in_place(
+      lhs, rhs,
+      [](biginteger_type &out, const biginteger_type &x, const biginteger_type &y) { out = x + y; }
+    );
+    benchmark::DoNotOptimize(output.data.data());
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_biginteger_add)->Apply(size_digits_args);
+
+void BM_biginteger_multiply(benchmark::State &state) {
+  biginteger_vector lhs(random_strings(state.range(0), state.range(1), false));
+  biginteger_vector rhs(random_strings(state.range(0), state.range(1), false));
+
+  for (auto _ : state) {
+    biginteger_vector output = binary_operation_in_place(
+      lhs, rhs,
+      [](biginteger_type &out, const biginteger_type &x, const biginteger_type &y) { out = x * y; }
+    );
+    benchmark::DoNotOptimize(output.data.data());
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_biginteger_multiply)->Apply(size_digits_args);
+
+// Schoolbook and Karatsuba multiplication, against NTT for large operands
+biginteger_type backend_multiply(const biginteger_type &x, const biginteger_type &y) { return x * y; }
+
+void BM_biginteger_multiply_large(benchmark::State &state, biginteger_type (*multiply)(const biginteger_type&, const biginteger_type&)) {
+  const biginteger_type lhs = random_integer(state.range(0));
+  const biginteger_type rhs = random_integer(state.range(0) - 1);
+
+  for (auto _ : state) {
+    biginteger_type output = multiply(lhs, rhs);
+    benchmark::DoNotOptimize(output.backend().limbs());
+  }
+}
+BENCHMARK_CAPTURE(BM_biginteger_multiply_large, backend, backend_multiply)->Apply(large_bits_args);
+BENCHMARK_CAPTURE(BM_biginteger_multiply_large, fast, fast_multiply)->Apply(large_bits_args);
+
+// Long division, against Newton iteration for large divisors
+biginteger_type backend_quotient(const biginteger_type &x, const biginteger_type &y) { return x / y; }
+
+void BM_biginteger_divide_large(benchmark::State &state, biginteger_type (*divide)(const biginteger_type&, const biginteger_type&)) {
+  const biginteger_type lhs = random_integer(2 * state.range(0));
+  const biginteger_type rhs = random_integer(state.range(0) - 1);
+
+  for (auto _ : state) {
+    biginteger_type output = divide(lhs, rhs);
+    benchmark::DoNotOptimize(output.backend().limbs());
+  }
+}
+BENCHMARK_CAPTURE(BM_biginteger_divide_large, backend, backend_quotient)->Apply(large_bits_args);
+BENCHMARK_CAPTURE(BM_biginteger_divide_large, fast, fast_quotient)->Apply(large_bits_args);
+
+void BM_bigfloat_multiply(benchmark::State &state) {
+  bigfloat_vector lhs(random_strings(state.range(0), state.range(1), true));
+  bigfloat_vector rhs(random_strings(state.range(0), state.range(1), true));
+
+  for (auto _ : state) {
+    bigfloat_vector output = binary_operation(
+      lhs, rhs,
+      [](const bigfloat_type &x, const bigfloat_type &y) { return x * y; }
+    );
+    benchmark::DoNotOptimize(output.data.data());
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_bigfloat_multiply)->Apply(size_digits_args);
+
+void BM_bigfloat_multiply_batch(benchmark::State &state) {
+  bigfloat_batch lhs(random_strings(state.range(0), state.range(1), true));
+  bigfloat_batch rhs(random_strings(state.range(0), state.range(1), true));
+
+  for (auto _ : state) {
+    bigfloat_batch output = bigfloat_batch_multiply(lhs, rhs);
+    benchmark::DoNotOptimize(output.limbs.data());
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_bigfloat_multiply_batch)->Apply(size_digits_args);
+
+void BM_bigfloat_add(benchmark::State &state) {
+  bigfloat_vector lhs(random_strings(state.range(0), state.range(1), true));
+  bigfloat_vector rhs(random_strings(state.range(0), state.range(1), true));
+
+  for (auto _ : state) {
+    bigfloat_vector output = binary_operation(
+      lhs, rhs,
+      [](const bigfloat_type &x, const bigfloat_type &y) { return x + y; }
+    );
+    benchmark::DoNotOptimize(output.data.data());
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_bigfloat_add)->Apply(size_digits_args);
+
+void BM_bigfloat_add_batch(benchmark::State &state) {
+  bigfloat_batch lhs(random_strings(state.range(0), state.range(1), true));
+  bigfloat_batch rhs(random_strings(state.range(0), state.range(1), true));
+
+  for (auto _ : state) {
+    bigfloat_batch output = bigfloat_batch_add(lhs, rhs);
+    benchmark::DoNotOptimize(output.limbs.data());
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_bigfloat_add_batch)->Apply(size_digits_args);
+
+// x^10, where small values run at a fixed width
+void BM_biginteger_pow(benchmark::State &state) {
+  biginteger_vector lhs(random_strings(state.range(0), state.range(1), false));
+  cpp11::integers rhs(std::vector<int>(state.range(0), 10));
+
+  for (auto _ : state) {
+    biginteger_vector output = fixed_width_operation(lhs, rhs, fixed_width_pow());
+    benchmark::DoNotOptimize(output.data.data());
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_biginteger_pow)->Apply(size_digits_args);
+
+
+/*--------------------------*
+ *  Ranking and reductions  *
+ *--------------------------*/
+void BM_biginteger_compare(benchmark::State &state) {
+  biginteger_vector lhs(random_strings(state.range(0), state.range(1), false));
+  biginteger_vector rhs(random_strings(state.range(0), state.range(1), false));
+
+  for (auto _ : state) {
+    cpp11::integers output = bignum_cmp(lhs, rhs, false);
+    benchmark::DoNotOptimize(output);
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_biginteger_compare)->Apply(size_digits_args);
+
+void BM_biginteger_compare_arena(benchmark::State &state) {
+  biginteger_arena lhs(random_strings(state.range(0), state.range(1), false));
+  biginteger_arena rhs(random_strings(state.range(0), state.range(1), false));
+
+  for (auto _ : state) {
+    cpp11::integers output = bignum_cmp(lhs, rhs, false);
+    benchmark::DoNotOptimize(output);
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_biginteger_compare_arena)->Apply(size_digits_args);
+
+void BM_biginteger_compare_text(benchmark::State &state) {
+  biginteger_text lhs(random_strings(state.range(0), state.range(1), false));
+  biginteger_text rhs(random_strings(state.range(0), state.range(1), false));
+
+  for (auto _ : state) {
+    cpp11::integers output = bignum_cmp(lhs, rhs, false);
+    benchmark::DoNotOptimize(output);
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_biginteger_compare_text)->Apply(size_digits_args);
+
+void BM_biginteger_equal_text(benchmark::State &state) {
+  biginteger_text lhs(random_strings(state.range(0), state.range(1), false));
+  biginteger_text rhs(random_strings(state.range(0), state.range(1), false));
+
+  for (auto _ : state) {
+    cpp11::logicals output = bignum_equal(lhs, rhs, false);
+    benchmark::DoNotOptimize(output);
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_biginteger_equal_text)->Apply(size_digits_args);
+
+void BM_biginteger_dense_rank(benchmark::State &state) {
+  biginteger_vector x(random_strings(state.range(0), state.range(1), false));
+
+  for (auto _ : state) {
+    cpp11::integers output = dense_rank<biginteger_type>(x);
+    benchmark::DoNotOptimize(output);
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_biginteger_dense_rank)->Apply(size_digits_args);
+
+void BM_biginteger_sum(benchmark::State &state) {
+  biginteger_vector x(random_strings(state.range(0), state.range(1), false));
+
+  for (auto _ : state) {
+    biginteger_vector output = accumulate_operation(
+      x, biginteger_vector(1, 0), false,
+      [](const biginteger_type &a, const biginteger_type &b) { return a + b; }
+    );
+    benchmark::DoNotOptimize(output.data.data());
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_biginteger_sum)->Apply(size_digits_args);
+
+void BM_bigfloat_sum(benchmark::State &state) {
+  bigfloat_vector x(random_strings(state.range(0), state.range(1), true));
+
+  for (auto _ : state) {
+    bigfloat_vector output = accumulate_operation(
+      x, bigfloat_vector(1, 0), false,
+      [](const bigfloat_type &a, const bigfloat_type &b) { return a + b; }
+    );
+    benchmark::DoNotOptimize(output.data.data());
+  }
+
+  set_counters(state);
+}
+BENCHMARK(BM_bigfloat_sum)->Apply(size_digits_args);
+
+BENCHMARK_MAIN();
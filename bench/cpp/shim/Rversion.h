@@ -0,0 +1,2 @@
+// ALTREP isn't available in the standalone benchmark, so R_VERSION is left
+// undefined and results are always formatted eagerly.
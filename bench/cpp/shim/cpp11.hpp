@@ -0,0 +1,111 @@
+// Minimal stand-in for the parts of the cpp11 API used by the bignum sources.
+//
+// This lets the package translation units (vector construction, formatting and
+// the templated kernels) be compiled into a standalone benchmark binary
+// without R. Vectors are plain std::vector containers; R's NA_STRING is
+// modelled by a null pointer.
+
+#ifndef __BIGNUM_BENCH_CPP11_SHIM__
+#define __BIGNUM_BENCH_CPP11_SHIM__
+
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct SEXPREC;
+typedef SEXPREC* SEXP;
+typedef std::ptrdiff_t R_xlen_t;
+
+#define NA_STRING (static_cast<SEXP>(nullptr))
+#define NA_INTEGER (-2147483647 - 1)
+#define NA_LOGICAL NA_INTEGER
+#define NA_REAL (std::numeric_limits<double>::quiet_NaN())
+#ifndef TRUE
+#define TRUE 1
+#endif
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+namespace cpp11 {
+
+class r_string {
+public:
+  r_string() : na_(true) {}
+  r_string(SEXP) : na_(true) {}
+  r_string(const char *x) : str_(x), na_(false) {}
+  r_string(const std::string &x) : str_(x), na_(false) {}
+
+  operator std::string() const { return str_; }
+  // strings aren't interned, so every element has its own identity
+  operator SEXP() const { return na_ ? nullptr : reinterpret_cast<SEXP>(const_cast<char*>(str_.c_str())); }
+  bool operator==(SEXP) const { return na_; }
+  bool operator!=(SEXP) const { return !na_; }
+  std::size_t size() const { return str_.size(); }
+  const char* c_str() const { return str_.c_str(); }
+
+private:
+  std::string str_;
+  bool na_;
+};
+
+class attribute_proxy {
+public:
+  attribute_proxy& operator=(std::initializer_list<const char*>) { return *this; }
+  template<class T> attribute_proxy& operator=(const T&) { return *this; }
+};
+
+template<class T>
+class r_vector {
+public:
+  r_vector() {}
+  explicit r_vector(R_xlen_t size) : data_(size) {}
+  r_vector(std::initializer_list<T> x) : data_(x) {}
+  r_vector(const std::vector<T> &x) : data_(x) {}
+
+  R_xlen_t size() const { return static_cast<R_xlen_t>(data_.size()); }
+  const T& operator[](R_xlen_t i) const { return data_[i]; }
+  T& operator[](R_xlen_t i) { return data_[i]; }
+  void push_back(const T &x) { data_.push_back(x); }
+  attribute_proxy attr(const char*) { return attribute_proxy(); }
+  // vectors aren't R objects, so can never be an ALTREP result
+  operator SEXP() const { return nullptr; }
+
+private:
+  std::vector<T> data_;
+};
+
+typedef r_vector<r_string> strings;
+typedef r_vector<int> integers;
+typedef r_vector<double> doubles;
+typedef r_vector<int> logicals;
+
+namespace writable {
+typedef ::cpp11::strings strings;
+typedef ::cpp11::integers integers;
+typedef ::cpp11::doubles doubles;
+typedef ::cpp11::logicals logicals;
+}
+
+inline void check_user_interrupt() {}
+
+template<class... Args>
+[[noreturn]] void stop(const char *fmt, Args...) {
+  throw std::runtime_error(fmt);
+}
+
+}
+
+inline const char* CHAR(const cpp11::r_string &x) { return x.c_str(); }
+
+// options() is always empty
+#define R_NilValue (static_cast<SEXP>(nullptr))
+inline SEXP Rf_install(const char*) { return R_NilValue; }
+inline SEXP Rf_GetOption1(SEXP) { return R_NilValue; }
+inline int Rf_asLogical(SEXP) { return NA_LOGICAL; }
+inline int Rf_asInteger(SEXP) { return NA_INTEGER; }
+
+#endif
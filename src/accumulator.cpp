@@ -0,0 +1,178 @@
+#include <memory>
+#include <string>
+#include <cpp11.hpp>
+#include "biginteger_vector.h"
+#include "bigfloat_vector.h"
+#include "summary.h"
+
+/*
+ * Streaming reductions over chunks of a vector.
+ *
+ * An accumulator keeps the summary statistics of every element seen so far
+ * in binary form, so each chunk is parsed once and the running result is
+ * only formatted when it is requested. Chunks are summarised in parallel,
+ * computing only the field the statistic needs (see summarise()), and
+ * accumulators of the same statistic and type merge like the blocks of a
+ * single vector.
+ */
+enum accumulator_statistic {
+  accumulate_sum,
+  accumulate_prod,
+  accumulate_min,
+  accumulate_max,
+  accumulate_mean
+};
+
+class accumulator {
+public:
+  accumulator(accumulator_statistic statistic, bool na_rm) : statistic(statistic), na_rm(na_rm) {}
+  virtual ~accumulator() {}
+
+  virtual accumulator* clone() const = 0;
+  virtual void update(cpp11::strings chunk) = 0;
+  // Returns false if `other` has a different statistic or type
+  virtual bool merge(const accumulator &other) = 0;
+  // NULL for the minimum or maximum of no elements
+  virtual SEXP result() const = 0;
+
+  const accumulator_statistic statistic;
+  const bool na_rm;
+};
+
+// Fields of summary_statistics needed for each statistic
+inline int accumulator_fields(accumulator_statistic statistic) {
+  switch (statistic) {
+  case accumulate_prod:
+    return summary_product;
+  case accumulate_min:
+  case accumulate_max:
+    return summary_extrema;
+  default:
+    return summary_sum;
+  }
+}
+
+template<class Vec, class T>
+class typed_accumulator : public accumulator {
+  summary_statistics<T> stats;
+
+public:
+  typed_accumulator(accumulator_statistic statistic, bool na_rm) : accumulator(statistic, na_rm) {}
+
+  accumulator* clone() const {
+    return new typed_accumulator(*this);
+  }
+
+  void update(cpp11::strings chunk) {
+    // A missing value already settles the result
+    if (stats.has_na) {
+      return;
+    }
+
+    const Vec input(chunk);
+    const int fields = accumulator_fields(statistic);
+    stats.merge(summarise(input.data, input.is_na, na_rm, fields), fields);
+  }
+
+  bool merge(const accumulator &other) {
+    const typed_accumulator *rhs = dynamic_cast<const typed_accumulator*>(&other);
+    if (rhs == NULL || rhs->statistic != statistic || rhs->na_rm != na_rm) {
+      return false;
+    }
+
+    stats.merge(rhs->stats, accumulator_fields(statistic));
+    return true;
+  }
+
+  SEXP result() const {
+    switch (statistic) {
+    case accumulate_sum:
+      return Vec(1, stats.sum, stats.has_na).encode();
+    case accumulate_prod:
+      return Vec(1, stats.product, stats.has_na).encode();
+    case accumulate_mean:
+      return summary_mean(stats).encode();
+    default:
+      if (!stats.has_na && stats.count == 0) {
+        return R_NilValue;
+      }
+      return Vec(1, statistic == accumulate_min ? stats.min : stats.max, stats.has_na).encode();
+    }
+  }
+};
+
+
+/*------------------*
+ *  Returning to R  *
+ *------------------*/
+static void finalize_accumulator(SEXP ptr) {
+  delete static_cast<accumulator*>(R_ExternalPtrAddr(ptr));
+  R_ClearExternalPtr(ptr);
+}
+
+static SEXP new_accumulator_pointer(accumulator *acc) {
+  SEXP ptr = PROTECT(R_MakeExternalPtr(acc, R_NilValue, R_NilValue));
+  R_RegisterCFinalizerEx(ptr, finalize_accumulator, TRUE);
+  UNPROTECT(1);
+  return ptr;
+}
+
+// The address is lost when the pointer is saved or sent to another process
+static accumulator* get_accumulator(SEXP ptr) {
+  accumulator *acc = TYPEOF(ptr) == EXTPTRSXP ? static_cast<accumulator*>(R_ExternalPtrAddr(ptr)) : NULL;
+  if (acc == NULL) {
+    cpp11::stop("Accumulator is no longer valid. It can't be used after being saved or sent to another R process.");
+  }
+  return acc;
+}
+
+[[cpp11::register]]
+SEXP c_accumulator_new(std::string statistic, std::string type, bool na_rm) {
+  accumulator_statistic stat;
+  if (statistic == "sum") {
+    stat = accumulate_sum;
+  } else if (statistic == "prod") {
+    stat = accumulate_prod;
+  } else if (statistic == "min") {
+    stat = accumulate_min;
+  } else if (statistic == "max") {
+    stat = accumulate_max;
+  } else if (statistic == "mean") {
+    stat = accumulate_mean;
+  } else {
+    cpp11::stop("Unknown statistic '%s'.", statistic.c_str()); // # nocov
+  }
+
+  std::unique_ptr<accumulator> acc;
+  if (type == "biginteger") {
+    acc.reset(new typed_accumulator<biginteger_vector, biginteger_type>(stat, na_rm));
+  } else {
+    acc.reset(new typed_accumulator<bigfloat_vector, bigfloat_type>(stat, na_rm));
+  }
+
+  SEXP ptr = new_accumulator_pointer(acc.get());
+  acc.release();
+  return ptr;
+}
+
+[[cpp11::register]]
+void c_accumulator_update(SEXP ptr, cpp11::strings chunk) {
+  get_accumulator(ptr)->update(chunk);
+}
+
+[[cpp11::register]]
+SEXP c_accumulator_merge(SEXP lhs, SEXP rhs) {
+  std::unique_ptr<accumulator> acc(get_accumulator(lhs)->clone());
+  if (!acc->merge(*get_accumulator(rhs))) {
+    cpp11::stop("Can't merge accumulators of different statistics or types."); // # nocov
+  }
+
+  SEXP ptr = new_accumulator_pointer(acc.get());
+  acc.release();
+  return ptr;
+}
+
+[[cpp11::register]]
+SEXP c_accumulator_result(SEXP ptr) {
+  return get_accumulator(ptr)->result();
+}
@@ -0,0 +1,585 @@
+#include "altrep.h"
+
+#ifdef BIGNUM_ALTREP
+
+#include <cstring>
+#include <memory>
+#include <R_ext/Altrep.h>
+#include "format.h"
+#include "interrupt.h"
+#include "options.h"
+
+namespace mp = boost::multiprecision;
+
+// Small results aren't worth the indirection
+static const std::size_t lazy_min_size = 128;
+
+bool use_lazy_encoding(std::size_t size) {
+  return size >= lazy_min_size && option_flag("bignum.lazy", true);
+}
+
+
+/*----------------------*
+ *  Rendering elements  *
+ *----------------------*/
+SEXP render_value(const biginteger_type &x) {
+  return Rf_mkCharCE(x.str().c_str(), CE_UTF8);
+}
+
+SEXP render_value(const bigfloat_type &x) {
+  if (mp::isnan(x)) {
+    return Rf_mkCharCE("NaN", CE_UTF8);
+  } else if (mp::isinf(x)) {
+    return Rf_mkCharCE(x > 0 ? "Inf" : "-Inf", CE_UTF8);
+  }
+
+  std::string str = format_bigfloat(
+    x,
+    bignum_format_dec,
+    std::numeric_limits<bigfloat_type>::max_digits10,
+    true
+  );
+  return Rf_mkCharCE(str.c_str(), CE_UTF8);
+}
+
+template<class Vec>
+SEXP render_element(const Vec &x, std::size_t i) {
+  return x.is_na[i] ? NA_STRING : render_value(x.data[i]);
+}
+
+cpp11::strings render_all(const biginteger_vector &x) {
+  return format_biginteger_vector(x, bignum_format_dec);
+}
+
+cpp11::strings render_all(const bigfloat_vector &x) {
+  return format_bigfloat_vector(x, bignum_format_dec, std::numeric_limits<bigfloat_type>::max_digits10, true);
+}
+
+
+/*------------------*
+ *  ALTREP helpers  *
+ *------------------*/
+
+// ALTREP methods are called from R's C code, so C++ exceptions (including
+// user interrupts) are turned back into R errors before returning. As in
+// END_CPP11, R only resumes unwinding once the exception has been destroyed.
+template<class Fn>
+auto altrep_guard(Fn fn) -> decltype(fn()) {
+  char message[8192] = "";
+  SEXP token = R_NilValue;
+  try {
+    return fn();
+  } catch (cpp11::unwind_exception &e) {
+    token = e.token;
+  } catch (std::exception &e) {
+    std::strncpy(message, e.what(), sizeof(message) - 1);
+  } catch (...) {
+    std::strncpy(message, "C++ error (unknown cause)", sizeof(message) - 1);
+  }
+
+  if (token != R_NilValue) {
+    R_ContinueUnwind(token);
+  }
+  Rf_errorcall(R_NilValue, "%s", message);
+}
+
+// data1 of our classes: external pointer to a payload, or R_NilValue once
+// the strings have been modified
+template<class Payload>
+Payload* get_payload(SEXP x) {
+  SEXP ptr = R_altrep_data1(x);
+  return ptr == R_NilValue ? NULL : static_cast<Payload*>(R_ExternalPtrAddr(ptr));
+}
+
+template<class Payload>
+void finalize_payload(SEXP ptr) {
+  delete static_cast<Payload*>(R_ExternalPtrAddr(ptr));
+  R_ClearExternalPtr(ptr);
+}
+
+template<class Payload>
+SEXP new_payload_altrep(R_altrep_class_t klass, Payload *p) {
+  SEXP ptr = PROTECT(R_MakeExternalPtr(p, R_NilValue, R_NilValue));
+  R_RegisterCFinalizerEx(ptr, finalize_payload<Payload>, TRUE);
+  SEXP out = R_new_altrep(klass, ptr, R_NilValue);
+  UNPROTECT(1);
+  return out;
+}
+
+// Drops the payload once the strings may be modified
+template<class Payload>
+void detach_payload(SEXP x) {
+  SEXP ptr = R_altrep_data1(x);
+  if (ptr != R_NilValue) {
+    finalize_payload<Payload>(ptr);
+    R_set_altrep_data1(x, R_NilValue);
+  }
+}
+
+// Converts a subscript of positive indices to 0-based positions. Returns
+// false for missing or out-of-bounds indices, which are left to R.
+bool subset_positions(SEXP indx, std::size_t size, std::vector<std::size_t> &positions) {
+  if (TYPEOF(indx) != INTSXP && TYPEOF(indx) != REALSXP) {
+    return false;
+  }
+
+  const R_xlen_t n = Rf_xlength(indx);
+  positions.resize(n);
+
+  for (R_xlen_t j=0; j<n; ++j) {
+    double k;
+    if (TYPEOF(indx) == INTSXP) {
+      int value = INTEGER_ELT(indx, j);
+      if (value == NA_INTEGER) return false;
+      k = value;
+    } else {
+      k = REAL_ELT(indx, j);
+      if (ISNAN(k)) return false;
+    }
+    if (k < 1 || k > size) {
+      return false;
+    }
+
+    positions[j] = static_cast<std::size_t>(k) - 1;
+  }
+
+  return true;
+}
+
+
+/*---------------------*
+ *  Lazy result class  *
+ *---------------------*/
+
+// data1: external pointer to the payload
+// data2: STRSXP of rendered strings (R_NilValue until first access)
+template<class Vec>
+struct lazy_payload {
+  explicit lazy_payload(Vec &&values) : values(std::move(values)), rendered(this->values.size()) {}
+
+  Vec values;
+  std::vector<bool> rendered;
+  std::size_t n_rendered = 0;
+};
+
+template<class Vec>
+class lazy_strings {
+public:
+  typedef lazy_payload<Vec> payload;
+
+  static R_altrep_class_t klass;
+
+  static SEXP make(Vec &&values) {
+    return new_payload_altrep(klass, new payload(std::move(values)));
+  }
+
+  static const Vec* values(SEXP x) {
+    if (!ALTREP(x) || !R_altrep_inherits(x, klass)) {
+      return NULL;
+    }
+    payload *p = get_payload<payload>(x);
+    return p == NULL ? NULL : &p->values;
+  }
+
+  static void init(const char *name, DllInfo *dll) {
+    klass = R_make_altstring_class(name, "bignum", dll);
+
+    R_set_altrep_Length_method(klass, length);
+    R_set_altrep_Inspect_method(klass, inspect);
+    R_set_altrep_Duplicate_method(klass, duplicate);
+    R_set_altrep_Serialized_state_method(klass, serialized_state);
+    R_set_altrep_Unserialize_method(klass, unserialize);
+
+    R_set_altvec_Dataptr_method(klass, dataptr);
+    R_set_altvec_Dataptr_or_null_method(klass, dataptr_or_null);
+    R_set_altvec_Extract_subset_method(klass, extract_subset);
+
+    R_set_altstring_Elt_method(klass, elt);
+    R_set_altstring_Set_elt_method(klass, set_elt);
+    R_set_altstring_No_NA_method(klass, no_na);
+  }
+
+private:
+  static SEXP cache(SEXP x, std::size_t size) {
+    SEXP strings = R_altrep_data2(x);
+    if (strings == R_NilValue) {
+      strings = Rf_allocVector(STRSXP, size);
+      R_set_altrep_data2(x, strings);
+    }
+    return strings;
+  }
+
+  // Renders all remaining elements
+  static SEXP materialize(SEXP x) {
+    payload *p = get_payload<payload>(x);
+    if (p == NULL || p->n_rendered == p->values.size()) {
+      return cache(x, p == NULL ? 0 : p->values.size());
+    }
+
+    if (p->n_rendered == 0) {
+      R_set_altrep_data2(x, render_all(p->values));
+    } else {
+      SEXP strings = R_altrep_data2(x);
+      for (interrupt_blocks block(p->values.size()); block.next(); ) {
+        for (std::size_t i=block.begin(); i<block.end(); ++i) {
+          if (!p->rendered[i]) {
+            SET_STRING_ELT(strings, i, render_element(p->values, i));
+          }
+        }
+      }
+    }
+
+    p->n_rendered = p->values.size();
+    std::vector<bool>().swap(p->rendered);
+    return R_altrep_data2(x);
+  }
+
+  static R_xlen_t length(SEXP x) {
+    payload *p = get_payload<payload>(x);
+    return p == NULL ? Rf_xlength(R_altrep_data2(x)) : p->values.size();
+  }
+
+  static SEXP elt(SEXP x, R_xlen_t i) {
+    payload *p = get_payload<payload>(x);
+    if (p == NULL || p->n_rendered == p->values.size()) {
+      return STRING_ELT(R_altrep_data2(x), i);
+    }
+
+    SEXP strings = cache(x, p->values.size());
+    if (!p->rendered[i]) {
+      SET_STRING_ELT(strings, i, altrep_guard([&]() { return render_element(p->values, i); }));
+      p->rendered[i] = true;
+      ++p->n_rendered;
+    }
+    return STRING_ELT(strings, i);
+  }
+
+  static void set_elt(SEXP x, R_xlen_t i, SEXP value) {
+    SEXP strings = altrep_guard([&]() { return materialize(x); });
+    detach_payload<payload>(x);
+    SET_STRING_ELT(strings, i, value);
+  }
+
+  static void* dataptr(SEXP x, Rboolean writeable) {
+    SEXP strings = altrep_guard([&]() { return materialize(x); });
+    if (writeable) {
+      detach_payload<payload>(x);
+    }
+    return const_cast<SEXP*>(STRING_PTR_RO(strings));
+  }
+
+  static const void* dataptr_or_null(SEXP x) {
+    payload *p = get_payload<payload>(x);
+    if (p != NULL && p->n_rendered < p->values.size()) {
+      return NULL;
+    }
+    return STRING_PTR_RO(materialize(x));
+  }
+
+  static int no_na(SEXP x) {
+    payload *p = get_payload<payload>(x);
+    if (p == NULL) {
+      return 0;
+    }
+    for (std::size_t i=0; i<p->values.size(); ++i) {
+      if (p->values.is_na[i]) {
+        return 0;
+      }
+    }
+    return 1;
+  }
+
+  // Subsets without rendering
+  static SEXP extract_subset(SEXP x, SEXP indx, SEXP call) {
+    payload *p = get_payload<payload>(x);
+    std::vector<std::size_t> positions;
+    if (p == NULL || !subset_positions(indx, p->values.size(), positions)) {
+      return NULL;
+    }
+
+    return altrep_guard([&]() {
+      Vec output(positions.size());
+      for (std::size_t j=0; j<positions.size(); ++j) {
+        output.data[j] = p->values.data[positions[j]];
+        output.is_na[j] = p->values.is_na[positions[j]];
+      }
+      return make(std::move(output));
+    });
+  }
+
+  static SEXP duplicate(SEXP x, Rboolean deep) {
+    payload *p = get_payload<payload>(x);
+    if (p == NULL) {
+      return NULL;
+    }
+    return altrep_guard([&]() { return make(Vec(p->values)); });
+  }
+
+  static SEXP serialized_state(SEXP x) {
+    return altrep_guard([&]() { return materialize(x); });
+  }
+
+  static SEXP unserialize(SEXP cls, SEXP state) {
+    return state;
+  }
+
+  static Rboolean inspect(SEXP x, int pre, int deep, int pvec, void (*inspect_subtree)(SEXP, int, int, int)) {
+    payload *p = get_payload<payload>(x);
+    if (p == NULL) {
+      Rprintf("bignum lazy strings (detached)\n");
+    } else {
+      Rprintf("bignum lazy strings (len=%d, rendered=%d)\n",
+              static_cast<int>(p->values.size()), static_cast<int>(p->n_rendered));
+    }
+    return TRUE;
+  }
+};
+
+template<class Vec>
+R_altrep_class_t lazy_strings<Vec>::klass;
+
+
+/*--------------------------*
+ *  Compact sequence class  *
+ *--------------------------*/
+
+// A subset of a sequence is itself a sequence if the positions are evenly
+// spaced. Rebasing a bigfloat sequence would round the new start and step,
+// so only leading subsets (e.g. head()) keep the original values exactly.
+inline bool can_rebase(const biginteger_sequence &seq, std::size_t first, std::size_t stride) {
+  return true;
+}
+
+inline bool can_rebase(const bigfloat_sequence &seq, std::size_t first, std::size_t stride) {
+  return first == 0 && stride == 1;
+}
+
+// data1: external pointer to the payload
+// data2: STRSXP of rendered strings (R_NilValue until materialized)
+template<class Seq, class Vec>
+struct sequence_payload {
+  explicit sequence_payload(const Seq &seq) : seq(seq) {}
+
+  Seq seq;
+  std::unique_ptr<Vec> values;  // computed on first use
+};
+
+template<class Seq, class Vec>
+class sequence_strings {
+public:
+  typedef sequence_payload<Seq, Vec> payload;
+
+  static R_altrep_class_t klass;
+
+  static SEXP make(const Seq &seq) {
+    return new_payload_altrep(klass, new payload(seq));
+  }
+
+  static const Seq* sequence(SEXP x) {
+    payload *p = get(x);
+    return p == NULL ? NULL : &p->seq;
+  }
+
+  static const Vec* values(SEXP x) {
+    payload *p = get(x);
+    if (p == NULL) {
+      return NULL;
+    }
+    if (!p->values) {
+      p->values.reset(new Vec(materialize_sequence(p->seq)));
+    }
+    return p->values.get();
+  }
+
+  static void init(const char *name, DllInfo *dll) {
+    klass = R_make_altstring_class(name, "bignum", dll);
+
+    R_set_altrep_Length_method(klass, length);
+    R_set_altrep_Inspect_method(klass, inspect);
+    R_set_altrep_Duplicate_method(klass, duplicate);
+    R_set_altrep_Serialized_state_method(klass, serialized_state);
+    R_set_altrep_Unserialize_method(klass, unserialize);
+
+    R_set_altvec_Dataptr_method(klass, dataptr);
+    R_set_altvec_Dataptr_or_null_method(klass, dataptr_or_null);
+    R_set_altvec_Extract_subset_method(klass, extract_subset);
+
+    R_set_altstring_Elt_method(klass, elt);
+    R_set_altstring_Set_elt_method(klass, set_elt);
+    R_set_altstring_No_NA_method(klass, no_na);
+  }
+
+private:
+  static payload* get(SEXP x) {
+    if (!ALTREP(x) || !R_altrep_inherits(x, klass)) {
+      return NULL;
+    }
+    return get_payload<payload>(x);
+  }
+
+  // Computes (in parallel) and renders every element
+  static SEXP materialize(SEXP x) {
+    SEXP strings = R_altrep_data2(x);
+    if (strings == R_NilValue) {
+      strings = render_all(*values(x));
+      R_set_altrep_data2(x, strings);
+    }
+    return strings;
+  }
+
+  static R_xlen_t length(SEXP x) {
+    payload *p = get_payload<payload>(x);
+    return p == NULL ? Rf_xlength(R_altrep_data2(x)) : p->seq.size;
+  }
+
+  // Elements are rendered on demand until the vector is materialized
+  static SEXP elt(SEXP x, R_xlen_t i) {
+    SEXP strings = R_altrep_data2(x);
+    if (strings != R_NilValue) {
+      return STRING_ELT(strings, i);
+    }
+    const Seq &seq = get_payload<payload>(x)->seq;
+    return altrep_guard([&]() { return render_value(seq[i]); });
+  }
+
+  static void set_elt(SEXP x, R_xlen_t i, SEXP value) {
+    SEXP strings = altrep_guard([&]() { return materialize(x); });
+    detach_payload<payload>(x);
+    SET_STRING_ELT(strings, i, value);
+  }
+
+  static void* dataptr(SEXP x, Rboolean writeable) {
+    SEXP strings = altrep_guard([&]() { return materialize(x); });
+    if (writeable) {
+      detach_payload<payload>(x);
+    }
+    return const_cast<SEXP*>(STRING_PTR_RO(strings));
+  }
+
+  static const void* dataptr_or_null(SEXP x) {
+    SEXP strings = R_altrep_data2(x);
+    return strings == R_NilValue ? NULL : STRING_PTR_RO(strings);
+  }
+
+  static int no_na(SEXP x) {
+    return get_payload<payload>(x) != NULL;
+  }
+
+  // Evenly spaced positions give another sequence, otherwise the selected
+  // values are returned as a lazy result
+  static SEXP extract_subset(SEXP x, SEXP indx, SEXP call) {
+    payload *p = get_payload<payload>(x);
+    std::vector<std::size_t> positions;
+    if (p == NULL || !subset_positions(indx, p->seq.size, positions)) {
+      return NULL;
+    }
+
+    return altrep_guard([&]() {
+      const Seq &seq = p->seq;
+      const std::size_t n = positions.size();
+
+      if (n < 2) {
+        return make(Seq(n == 0 ? seq.start : seq[positions[0]], seq.step, n));
+      }
+
+      bool evenly_spaced = positions[1] > positions[0];
+      const std::size_t stride = positions[1] - positions[0];
+      for (std::size_t j=2; evenly_spaced && j<n; ++j) {
+        evenly_spaced = positions[j] - positions[j - 1] == stride;
+      }
+
+      if (evenly_spaced && can_rebase(seq, positions[0], stride)) {
+        return make(Seq(seq[positions[0]], seq.step * stride, n));
+      }
+
+      Vec output(n);
+      for (std::size_t j=0; j<n; ++j) {
+        output.data[j] = seq[positions[j]];
+      }
+      return lazy_strings<Vec>::make(std::move(output));
+    });
+  }
+
+  static SEXP duplicate(SEXP x, Rboolean deep) {
+    payload *p = get_payload<payload>(x);
+    if (p == NULL) {
+      return NULL;
+    }
+    return altrep_guard([&]() { return make(p->seq); });
+  }
+
+  static SEXP serialized_state(SEXP x) {
+    return altrep_guard([&]() { return materialize(x); });
+  }
+
+  static SEXP unserialize(SEXP cls, SEXP state) {
+    return state;
+  }
+
+  static Rboolean inspect(SEXP x, int pre, int deep, int pvec, void (*inspect_subtree)(SEXP, int, int, int)) {
+    payload *p = get_payload<payload>(x);
+    if (p == NULL) {
+      Rprintf("bignum sequence (detached)\n");
+    } else {
+      Rprintf("bignum sequence (len=%d, from=%s, by=%s, materialized=%s)\n",
+              static_cast<int>(p->seq.size),
+              p->seq.start.str().c_str(),
+              p->seq.step.str().c_str(),
+              R_altrep_data2(x) == R_NilValue ? "no" : "yes");
+    }
+    return TRUE;
+  }
+};
+
+template<class Seq, class Vec>
+R_altrep_class_t sequence_strings<Seq, Vec>::klass;
+
+typedef sequence_strings<biginteger_sequence, biginteger_vector> biginteger_sequence_strings;
+typedef sequence_strings<bigfloat_sequence, bigfloat_vector> bigfloat_sequence_strings;
+
+
+SEXP new_lazy_strings(biginteger_vector &&x) {
+  return lazy_strings<biginteger_vector>::make(std::move(x));
+}
+
+SEXP new_lazy_strings(bigfloat_vector &&x) {
+  return lazy_strings<bigfloat_vector>::make(std::move(x));
+}
+
+SEXP new_sequence_strings(const biginteger_sequence &x) {
+  return biginteger_sequence_strings::make(x);
+}
+
+SEXP new_sequence_strings(const bigfloat_sequence &x) {
+  return bigfloat_sequence_strings::make(x);
+}
+
+const biginteger_vector* lazy_biginteger_values(SEXP x) {
+  const biginteger_vector *values = lazy_strings<biginteger_vector>::values(x);
+  return values != NULL ? values : biginteger_sequence_strings::values(x);
+}
+
+const bigfloat_vector* lazy_bigfloat_values(SEXP x) {
+  const bigfloat_vector *values = lazy_strings<bigfloat_vector>::values(x);
+  return values != NULL ? values : bigfloat_sequence_strings::values(x);
+}
+
+const biginteger_sequence* lazy_biginteger_sequence(SEXP x) {
+  return biginteger_sequence_strings::sequence(x);
+}
+
+const bigfloat_sequence* lazy_bigfloat_sequence(SEXP x) {
+  return bigfloat_sequence_strings::sequence(x);
+}
+
+#endif
+
+[[cpp11::init]]
+void init_lazy_strings(DllInfo* dll) {
+#ifdef BIGNUM_ALTREP
+  lazy_strings<biginteger_vector>::init("bignum_biginteger_lazy", dll);
+  lazy_strings<bigfloat_vector>::init("bignum_bigfloat_lazy", dll);
+  biginteger_sequence_strings::init("bignum_biginteger_seq", dll);
+  bigfloat_sequence_strings::init("bignum_bigfloat_seq", dll);
+#endif
+}
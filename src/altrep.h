@@ -0,0 +1,55 @@
+#ifndef __BIGNUM_ALTREP__
+#define __BIGNUM_ALTREP__
+
+#include <cpp11.hpp>
+#include <Rversion.h>
+#include "biginteger_vector.h"
+#include "bigfloat_vector.h"
+#include "sequence.h"
+
+/*
+ * Lazy results: instead of formatting every element when a result is
+ * returned to R, the parsed values are kept in an ALTREP character vector.
+ * Decimal strings are only rendered for elements that R actually reads, and
+ * other bignum functions use the stored values without parsing.
+ *
+ * Requires the ALTSTRING methods added in R 3.6.0.
+ */
+#ifdef R_VERSION
+#if R_VERSION >= R_Version(3, 6, 0)
+#define BIGNUM_ALTREP
+#endif
+#endif
+
+#ifdef BIGNUM_ALTREP
+
+// Should a result of this size be returned lazily?
+bool use_lazy_encoding(std::size_t size);
+
+// Takes ownership of the values (no class attribute is set)
+SEXP new_lazy_strings(biginteger_vector &&x);
+SEXP new_lazy_strings(bigfloat_vector &&x);
+
+// Values held by a lazy vector, or NULL if `x` isn't one of ours (or was
+// modified after creation)
+const biginteger_vector* lazy_biginteger_values(SEXP x);
+const bigfloat_vector* lazy_bigfloat_values(SEXP x);
+
+// Compact arithmetic sequences (no class attribute is set)
+SEXP new_sequence_strings(const biginteger_sequence &x);
+SEXP new_sequence_strings(const bigfloat_sequence &x);
+
+// Sequence held by a compact vector, or NULL if `x` isn't one
+const biginteger_sequence* lazy_biginteger_sequence(SEXP x);
+const bigfloat_sequence* lazy_bigfloat_sequence(SEXP x);
+
+#else
+
+inline const biginteger_vector* lazy_biginteger_values(SEXP) { return NULL; }
+inline const bigfloat_vector* lazy_bigfloat_values(SEXP) { return NULL; }
+inline const biginteger_sequence* lazy_biginteger_sequence(SEXP) { return NULL; }
+inline const bigfloat_sequence* lazy_bigfloat_sequence(SEXP) { return NULL; }
+
+#endif
+
+#endif
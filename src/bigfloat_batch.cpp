@@ -0,0 +1,582 @@
+#include "bigfloat_batch.h"
+#include "cache.h"
+#include "interrupt.h"
+#include "altrep.h"
+
+/*
+ * The kernels below follow the algorithms of Boost's cpp_bin_float step by
+ * step (special values first, then exact fixed-width limb arithmetic, then a
+ * single rounding), so they return bit-identical results. Each element is
+ * gathered from the planes into a few local limbs, which the compiler keeps
+ * in registers, and the result is scattered back.
+ */
+
+namespace {
+
+typedef bigfloat_batch::limb_type limb_type;
+typedef bigfloat_batch::exponent_type exponent_type;
+typedef boost::multiprecision::double_limb_type double_limb_type;
+
+const int bit_count = bigfloat_batch::bit_count;
+const unsigned limb_bits = bigfloat_batch::limb_bits;
+const unsigned n_limbs = bigfloat_batch::n_limbs;
+// Wide enough for a product, or a mantissa shifted by up to bit_count bits
+const unsigned n_wide = 2 * n_limbs;
+
+const exponent_type max_exponent = bigfloat_batch::backend_type::max_exponent;
+const exponent_type min_exponent = bigfloat_batch::backend_type::min_exponent;
+
+struct element {
+  limb_type m[n_limbs];
+  exponent_type e;
+  bool sign;
+  unsigned char kind;
+};
+
+// Exponent ordering used by Boost, where special values sort above finite ones
+exponent_type raw_exponent(const element &x) {
+  switch (x.kind) {
+  case bigfloat_batch::zero: return max_exponent + 1;
+  case bigfloat_batch::infinite: return max_exponent + 2;
+  case bigfloat_batch::nan: return max_exponent + 3;
+  default: return x.e;
+  }
+}
+
+void set_special(element &x, unsigned char kind, bool sign) {
+  x.kind = kind;
+  x.sign = sign;
+}
+
+void load(const bigfloat_batch &x, std::size_t i, element &out) {
+  out.kind = x.kind[i];
+  out.sign = x.sign[i];
+  out.e = x.exponent[i];
+  for (unsigned k=0; k<n_limbs; ++k) {
+    out.m[k] = x.plane(k)[i];
+  }
+}
+
+void store(const element &x, bigfloat_batch &out, std::size_t i) {
+  out.kind[i] = x.kind;
+  out.sign[i] = x.sign;
+  if (x.kind == bigfloat_batch::finite) {
+    out.exponent[i] = x.e;
+    for (unsigned k=0; k<n_limbs; ++k) {
+      out.plane(k)[i] = x.m[k];
+    }
+  }
+}
+
+
+/*------------------------*
+ *  Fixed-width integers  *
+ *------------------------*/
+bool bit_test(const limb_type *x, int bit) {
+  return (x[bit / limb_bits] >> (bit % limb_bits)) & 1;
+}
+
+// Are any of the bits below `bit` set?
+bool any_below(const limb_type *x, int bit) {
+  const unsigned q = bit / limb_bits, r = bit % limb_bits;
+  for (unsigned k=0; k<q; ++k) {
+    if (x[k] != 0) {
+      return true;
+    }
+  }
+  return r > 0 && (x[q] & ((limb_type(1) << r) - 1)) != 0;
+}
+
+// Highest set bit, or -1 for zero
+int msb(const limb_type *x, unsigned n) {
+  for (unsigned k=n; k>0; --k) {
+    if (x[k - 1] != 0) {
+      return (k - 1) * limb_bits + boost::multiprecision::msb(x[k - 1]);
+    }
+  }
+  return -1;
+}
+
+// x = m << shift
+void shift_left(const limb_type *m, unsigned shift, limb_type *x) {
+  const unsigned q = shift / limb_bits, r = shift % limb_bits;
+  for (unsigned k=0; k<n_wide; ++k) {
+    x[k] = 0;
+  }
+  for (unsigned k=0; k<n_limbs; ++k) {
+    x[k + q] |= m[k] << r;
+    if (r > 0 && k + q + 1 < n_wide) {
+      x[k + q + 1] |= m[k] >> (limb_bits - r);
+    }
+  }
+}
+
+void add_to(limb_type *x, const limb_type *m) {
+  double_limb_type carry = 0;
+  for (unsigned k=0; k<n_wide; ++k) {
+    carry += static_cast<double_limb_type>(x[k]) + (k < n_limbs ? m[k] : 0);
+    x[k] = static_cast<limb_type>(carry);
+    carry >>= limb_bits;
+  }
+}
+
+// x -= m (x >= m)
+void subtract_from(limb_type *x, const limb_type *m) {
+  limb_type borrow = 0;
+  for (unsigned k=0; k<n_wide; ++k) {
+    const limb_type y = k < n_limbs ? m[k] : 0;
+    const limb_type diff = x[k] - y - borrow;
+    borrow = (x[k] < y || (x[k] == y && borrow)) ? 1 : 0;
+    x[k] = diff;
+  }
+}
+
+void multiply(const limb_type *a, const limb_type *b, limb_type *x) {
+  for (unsigned k=0; k<n_wide; ++k) {
+    x[k] = 0;
+  }
+  for (unsigned i=0; i<n_limbs; ++i) {
+    double_limb_type carry = 0;
+    for (unsigned j=0; j<n_limbs; ++j) {
+      carry += static_cast<double_limb_type>(a[i]) * b[j] + x[i + j];
+      x[i + j] = static_cast<limb_type>(carry);
+      carry >>= limb_bits;
+    }
+    x[i + n_limbs] = static_cast<limb_type>(carry);
+  }
+}
+
+int compare_mantissas(const limb_type *a, const limb_type *b) {
+  for (unsigned k=n_limbs; k>0; --k) {
+    if (a[k - 1] != b[k - 1]) {
+      return a[k - 1] < b[k - 1] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+
+/*--------------*
+ *  Rounding    *
+ *--------------*/
+// Rounds the non-zero `x` to a mantissa (ties to even), adjusting the
+// exponent, then checks for overflow and underflow (like copy_and_round)
+void round_to(const limb_type *x, element &out) {
+  const int top = msb(x, n_wide);
+  const int keep = bit_count - 1;
+  out.kind = bigfloat_batch::finite;
+
+  if (top <= keep) {
+    // cancellation: shift left
+    const unsigned shift = keep - top;
+    const unsigned q = shift / limb_bits, r = shift % limb_bits;
+    for (unsigned k=0; k<n_limbs; ++k) {
+      limb_type limb = k >= q ? x[k - q] << r : 0;
+      if (r > 0 && k >= q + 1) {
+        limb |= x[k - q - 1] >> (limb_bits - r);
+      }
+      out.m[k] = limb;
+    }
+    out.e -= shift;
+  } else {
+    const unsigned shift = top - keep;
+    const unsigned q = shift / limb_bits, r = shift % limb_bits;
+    for (unsigned k=0; k<n_limbs; ++k) {
+      limb_type limb = x[k + q] >> r;
+      if (r > 0 && k + q + 1 < n_wide) {
+        limb |= x[k + q + 1] << (limb_bits - r);
+      }
+      out.m[k] = limb;
+    }
+    out.e += shift;
+
+    bool round_up = bit_test(x, shift - 1);
+    if (round_up && !any_below(x, shift - 1)) {
+      round_up = out.m[0] & 1;
+    }
+    if (round_up) {
+      for (unsigned k=0; k<n_limbs && ++out.m[k] == 0; ++k) {}
+      if (bit_test(out.m, bit_count)) {
+        for (unsigned k=0; k<n_limbs; ++k) {
+          out.m[k] = (out.m[k] >> 1) | (k + 1 < n_limbs ? out.m[k + 1] << (limb_bits - 1) : 0);
+        }
+        ++out.e;
+      }
+    }
+  }
+
+  if (out.e > max_exponent) {
+    out.kind = bigfloat_batch::infinite;
+  } else if (out.e < min_exponent) {
+    out.kind = bigfloat_batch::zero;
+  }
+}
+
+
+/*----------------*
+ *  Element math  *
+ *----------------*/
+// a + b, where a and b have the same sign (do_eval_add)
+void add_magnitudes(const element &lhs, const element &rhs, element &out) {
+  const bool s = lhs.sign;
+  const bool swap = raw_exponent(lhs) < raw_exponent(rhs);
+  const element &a = swap ? rhs : lhs;
+  const element &b = swap ? lhs : rhs;
+
+  switch (a.kind) {
+  case bigfloat_batch::zero:
+    out = b;
+    out.sign = s;
+    return;
+  case bigfloat_batch::infinite:
+    // negation leaves the sign of NaN alone
+    if (b.kind == bigfloat_batch::nan) {
+      out = b;
+    } else {
+      out = a;
+      out.sign = s;
+    }
+    return;
+  case bigfloat_batch::nan:
+    out = a;
+    return;
+  }
+  switch (b.kind) {
+  case bigfloat_batch::zero:
+    out = a;
+    out.sign = s;
+    return;
+  case bigfloat_batch::infinite:
+  case bigfloat_batch::nan:
+    out = b; // # nocov (b has the smaller exponent)
+    out.sign = s; // # nocov
+    return; // # nocov
+  }
+
+  limb_type x[n_wide];
+  if (a.e > bit_count + b.e) {
+    shift_left(a.m, 0, x);
+    out.e = a.e;
+  } else {
+    shift_left(a.m, a.e - b.e, x);
+    add_to(x, b.m);
+    out.e = b.e;
+  }
+
+  round_to(x, out);
+  out.sign = s;
+}
+
+// a - b in magnitude, with the sign of a (do_eval_subtract)
+void subtract_magnitudes(const element &a, const element &b, element &out) {
+  switch (a.kind) {
+  case bigfloat_batch::zero:
+    if (b.kind == bigfloat_batch::nan) {
+      set_special(out, bigfloat_batch::nan, false);
+    } else {
+      out = b;
+      out.sign = b.kind == bigfloat_batch::zero ? false : !a.sign;
+    }
+    return;
+  case bigfloat_batch::infinite:
+    if (b.kind == bigfloat_batch::nan || b.kind == bigfloat_batch::infinite) {
+      set_special(out, bigfloat_batch::nan, false);
+    } else {
+      out = a;
+    }
+    return;
+  case bigfloat_batch::nan:
+    out = a;
+    return;
+  }
+  switch (b.kind) {
+  case bigfloat_batch::zero:
+    out = a;
+    return;
+  case bigfloat_batch::infinite:
+    set_special(out, bigfloat_batch::infinite, !a.sign);
+    return;
+  case bigfloat_batch::nan:
+    out = b;
+    return;
+  }
+
+  const bool a_larger = a.e > b.e || (a.e == b.e && compare_mantissas(a.m, b.m) >= 0);
+  const element &big = a_larger ? a : b;
+  const element &small = a_larger ? b : a;
+  const bool s = a_larger ? a.sign : !a.sign;
+
+  limb_type x[n_wide];
+  if (big.e <= bit_count + small.e) {
+    shift_left(big.m, big.e - small.e, x);
+    subtract_from(x, small.m);
+    out.e = small.e;
+  } else if (big.e == bit_count + small.e + 1 && any_below(small.m, bit_count - 1)) {
+    // big minus a little: one bit more is enough to round correctly
+    const limb_type one[n_limbs] = {1};
+    shift_left(big.m, 1, x);
+    subtract_from(x, one);
+    out.e = big.e - 1;
+  } else {
+    shift_left(big.m, 0, x);
+    out.e = big.e;
+  }
+
+  if (msb(x, n_wide) < 0) {
+    set_special(out, bigfloat_batch::zero, false);
+    return;
+  }
+  round_to(x, out);
+  out.sign = out.kind == bigfloat_batch::zero ? false : s;
+}
+
+void multiply_elements(const element &a, const element &b, element &out) {
+  const bool s = a.sign != b.sign;
+
+  switch (a.kind) {
+  case bigfloat_batch::zero:
+    if (b.kind == bigfloat_batch::nan) {
+      out = b;
+    } else if (b.kind == bigfloat_batch::infinite) {
+      set_special(out, bigfloat_batch::nan, false);
+    } else {
+      set_special(out, bigfloat_batch::zero, s);
+    }
+    return;
+  case bigfloat_batch::infinite:
+    if (b.kind == bigfloat_batch::zero) {
+      set_special(out, bigfloat_batch::nan, false);
+    } else if (b.kind == bigfloat_batch::nan) {
+      out = b;
+    } else {
+      set_special(out, bigfloat_batch::infinite, s);
+    }
+    return;
+  case bigfloat_batch::nan:
+    out = a;
+    return;
+  }
+  if (b.kind != bigfloat_batch::finite) {
+    out = b;
+    out.sign = s;
+    return;
+  }
+
+  // certain overflow or underflow
+  if (a.e > 0 && b.e > 0 && max_exponent + 2 - a.e < b.e) {
+    set_special(out, bigfloat_batch::infinite, s);
+    return;
+  }
+  if (a.e < 0 && b.e < 0 && min_exponent - 2 - a.e > b.e) {
+    set_special(out, bigfloat_batch::zero, s);
+    return;
+  }
+
+  limb_type x[n_wide];
+  multiply(a.m, b.m, x);
+  out.e = a.e + b.e - bit_count + 1;
+  round_to(x, out);
+  out.sign = s;
+}
+
+template<class Func>
+bigfloat_batch batch_operation(const bigfloat_batch &lhs, const bigfloat_batch &rhs, const Func &op) {
+  if (lhs.size() != rhs.size()) {
+    cpp11::stop("Incompatible sizes"); // # nocov
+  }
+
+  bigfloat_batch output(lhs.size());
+  element a, b, result;
+
+  for (interrupt_blocks block(lhs.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (lhs.is_na[i] || rhs.is_na[i]) {
+        output.is_na[i] = true;
+        continue;
+      }
+
+      load(lhs, i, a);
+      load(rhs, i, b);
+      op(a, b, result);
+      store(result, output, i);
+    }
+  }
+
+  return output;
+}
+
+}
+
+
+/*------------------*
+ *  bigfloat_batch  *
+ *------------------*/
+bigfloat_batch::bigfloat_batch(const bigfloat_vector &x) : bigfloat_batch(x.size()) {
+  for (interrupt_blocks block(x.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (x.is_na[i]) {
+        is_na[i] = true;
+      } else {
+        assign(i, x.data[i]);
+      }
+    }
+  }
+}
+
+bigfloat_batch::bigfloat_batch(cpp11::strings x) : bigfloat_batch(x.size()) {
+  // values of a lazy result don't need parsing
+  const bigfloat_vector *lazy = lazy_bigfloat_values(x);
+  if (lazy != NULL) {
+    *this = bigfloat_batch(*lazy);
+    return;
+  }
+
+  std::size_t vsize = x.size();
+  parse_cache cache(vsize);
+  bigfloat_type scratch;
+  for (interrupt_blocks block(vsize); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      std::size_t first;
+      if (x[i] == NA_STRING) {
+        is_na[i] = true;
+      } else if (cache.find(x[i], i, first)) {
+        element value;
+        load(*this, first, value);
+        store(value, *this, i);
+        is_na[i] = is_na[first];
+      } else {
+        const char *str = CHAR(x[i]);
+        if (parse_bigfloat(str, str + x[i].size(), scratch)) {
+          assign(i, scratch);
+        } else {
+          is_na[i] = true;
+        }
+      }
+    }
+  }
+}
+
+void bigfloat_batch::assign(std::size_t i, const bigfloat_type &value) {
+  const backend_type &x = value.backend();
+  sign[i] = x.sign();
+
+  if (x.exponent() == backend_type::exponent_zero) {
+    kind[i] = zero;
+  } else if (x.exponent() == backend_type::exponent_infinity) {
+    kind[i] = infinite;
+  } else if (x.exponent() == backend_type::exponent_nan) {
+    kind[i] = nan;
+  } else {
+    kind[i] = finite;
+    exponent[i] = x.exponent();
+    for (unsigned k=0; k<n_limbs; ++k) {
+      plane(k)[i] = x.bits().limbs()[k];
+    }
+  }
+}
+
+bigfloat_type bigfloat_batch::value(std::size_t i) const {
+  bigfloat_type output;
+  backend_type &x = output.backend();
+
+  switch (kind[i]) {
+  case zero:
+    x.exponent() = backend_type::exponent_zero;
+    break;
+  case infinite:
+    x.exponent() = backend_type::exponent_infinity;
+    break;
+  case nan:
+    x.exponent() = backend_type::exponent_nan;
+    break;
+  default:
+    x.exponent() = exponent[i];
+    x.bits().resize(n_limbs, n_limbs);
+    for (unsigned k=0; k<n_limbs; ++k) {
+      x.bits().limbs()[k] = plane(k)[i];
+    }
+    x.bits().normalize();
+  }
+  x.sign() = sign[i];
+
+  return output;
+}
+
+int bigfloat_batch::compare(std::size_t i, const bigfloat_batch &rhs) const {
+  if (kind[i] == nan || rhs.kind[i] == nan) {
+    return 0;
+  }
+  if (kind[i] == zero && rhs.kind[i] == zero) {
+    return 0;
+  }
+
+  const bool lhs_negative = sign[i] && kind[i] != zero;
+  const bool rhs_negative = rhs.sign[i] && rhs.kind[i] != zero;
+  if (lhs_negative != rhs_negative) {
+    return lhs_negative ? -1 : 1;
+  }
+
+  // zero < finite < infinite, then by exponent and mantissa
+  static const int rank[] = {1, 0, 2, 3};
+  int magnitude = rank[kind[i]] - rank[rhs.kind[i]];
+  if (magnitude == 0 && kind[i] == finite) {
+    if (exponent[i] != rhs.exponent[i]) {
+      magnitude = exponent[i] < rhs.exponent[i] ? -1 : 1;
+    } else {
+      for (unsigned k=n_limbs; k>0; --k) {
+        const limb_type x = plane(k - 1)[i], y = rhs.plane(k - 1)[i];
+        if (x != y) {
+          magnitude = x < y ? -1 : 1;
+          break;
+        }
+      }
+    }
+  }
+  magnitude = magnitude < 0 ? -1 : (magnitude > 0 ? 1 : 0);
+
+  return lhs_negative ? -magnitude : magnitude;
+}
+
+bigfloat_vector bigfloat_batch::to_vector() const {
+  bigfloat_vector output(size());
+
+  for (interrupt_blocks block(size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (is_na[i]) {
+        output.is_na[i] = true;
+      } else {
+        output.data[i] = value(i);
+      }
+    }
+  }
+
+  return output;
+}
+
+
+/*-----------*
+ *  Kernels  *
+ *-----------*/
+bigfloat_batch bigfloat_batch_add(const bigfloat_batch &lhs, const bigfloat_batch &rhs) {
+  return batch_operation(lhs, rhs, [](const element &a, const element &b, element &out) {
+    if (a.sign == b.sign) {
+      add_magnitudes(a, b, out);
+    } else {
+      subtract_magnitudes(a, b, out);
+    }
+  });
+}
+
+bigfloat_batch bigfloat_batch_subtract(const bigfloat_batch &lhs, const bigfloat_batch &rhs) {
+  return batch_operation(lhs, rhs, [](const element &a, const element &b, element &out) {
+    if (a.sign != b.sign) {
+      add_magnitudes(a, b, out);
+    } else {
+      subtract_magnitudes(a, b, out);
+    }
+  });
+}
+
+bigfloat_batch bigfloat_batch_multiply(const bigfloat_batch &lhs, const bigfloat_batch &rhs) {
+  return batch_operation(lhs, rhs, multiply_elements);
+}
@@ -0,0 +1,72 @@
+#ifndef __BIGFLOAT_BATCH__
+#define __BIGFLOAT_BATCH__
+
+#include <climits>
+#include <vector>
+#include <cpp11.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include "bigfloat_vector.h"
+
+/*
+ * Bigfloat values stored as a structure of arrays.
+ *
+ * A bigfloat is a fixed-width mantissa (normalized so its top bit is set),
+ * a binary exponent and a sign. Here, limb `k` of every mantissa is stored
+ * in plane `k`, next to arrays of exponents, signs and classes (finite,
+ * zero, infinite or NaN). Batch kernels (see bigfloat_batch.cpp) process
+ * whole planes with fixed-width limb arithmetic, instead of calling the
+ * generic backend for each element.
+ *
+ * Results are identical to those of bigfloat_type, including the rounding
+ * (to nearest, ties to even), overflow, underflow and signed zeros.
+ */
+class bigfloat_batch {
+public:
+  typedef bigfloat_type::backend_type backend_type;
+  typedef backend_type::exponent_type exponent_type;
+  typedef boost::multiprecision::limb_type limb_type;
+
+  static const unsigned bit_count = backend_type::bit_count;
+  static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+  static const unsigned n_limbs = (bit_count + limb_bits - 1) / limb_bits;
+
+  enum value_class : unsigned char { finite, zero, infinite, nan };
+
+  std::vector<limb_type> limbs;
+  std::vector<exponent_type> exponent;
+  std::vector<unsigned char> sign;
+  std::vector<unsigned char> kind;
+  std::vector<bool> is_na;
+  std::size_t size() const { return exponent.size(); }
+
+
+  explicit bigfloat_batch(std::size_t count = 0)
+    : limbs(count * n_limbs), exponent(count), sign(count), kind(count, zero), is_na(count) {}
+
+  explicit bigfloat_batch(const bigfloat_vector &x);
+  bigfloat_batch(cpp11::strings x);
+
+  // Limb `k` of every mantissa (least significant first)
+  limb_type* plane(unsigned k) { return limbs.data() + k * size(); }
+  const limb_type* plane(unsigned k) const { return limbs.data() + k * size(); }
+
+  void assign(std::size_t i, const bigfloat_type &value);
+  bigfloat_type value(std::size_t i) const;
+
+  // Three-way comparison of element `i` with element `i` of `rhs` (not NA).
+  // NaN compares equal to everything, like the comparison operators.
+  int compare(std::size_t i, const bigfloat_batch &rhs) const;
+
+  bigfloat_vector to_vector() const;
+};
+
+bigfloat_batch bigfloat_batch_add(const bigfloat_batch &lhs, const bigfloat_batch &rhs);
+bigfloat_batch bigfloat_batch_subtract(const bigfloat_batch &lhs, const bigfloat_batch &rhs);
+bigfloat_batch bigfloat_batch_multiply(const bigfloat_batch &lhs, const bigfloat_batch &rhs);
+
+// Comparisons read the planes directly (see compare.h)
+inline int compare_elements(const bigfloat_batch &lhs, const bigfloat_batch &rhs, std::size_t i) {
+  return lhs.compare(i, rhs);
+}
+
+#endif
@@ -1,8 +1,19 @@
+#include <cstring>
 #include <cpp11.hpp>
+#include <boost/math/special_functions/next.hpp>
 #include "bigfloat_vector.h"
+#include "bigfloat_batch.h"
+#include "bigfloat_operand.h"
+#include "biginteger_vector.h"
 #include "operations.h"
 #include "compare.h"
 #include "format.h"
+#include "cast.h"
+#include "interrupt.h"
+#include "trigonometry.h"
+#include "summary.h"
+#include "sequence.h"
+#include "altrep.h"
 
 namespace mp = boost::multiprecision;
 
@@ -16,72 +27,114 @@ cpp11::strings c_bigfloat(cpp11::strings x) {
  *  Casting  *
  *-----------*/
 [[cpp11::register]]
-cpp11::logicals c_bigfloat_to_logical(cpp11::strings x) {
+cpp11::list c_bigfloat_to_logical(cpp11::strings x) {
   bigfloat_vector input(x);
   cpp11::writable::logicals output(input.size());
-
-  for (std::size_t i=0; i<input.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
-
-    if (input.is_na[i]) {
-      output[i] = NA_LOGICAL;
-    } else if (mp::isnan(input.data[i])) {
-      output[i] = NA_LOGICAL;
-    } else {
-      output[i] = input.data[i] == 0 ? FALSE : TRUE;
+  cpp11::writable::logicals lossy(input.size());
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (input.is_na[i] || mp::isnan(input.data[i])) {
+        output[i] = NA_LOGICAL;
+        lossy[i] = FALSE;
+      } else {
+        output[i] = input.data[i] == 0 ? FALSE : TRUE;
+        lossy[i] = input.data[i] == 0 || input.data[i] == 1 ? FALSE : TRUE;
+      }
     }
   }
 
-  return output;
+  return cast_result(output, lossy);
 }
 
 [[cpp11::register]]
-cpp11::integers c_bigfloat_to_integer(cpp11::strings x) {
+cpp11::list c_bigfloat_to_integer(cpp11::strings x) {
   bigfloat_vector input(x);
   cpp11::writable::integers output(input.size());
+  cpp11::writable::logicals lossy(input.size());
 
+  // INT_MIN is NA_integer_
   int vmax = std::numeric_limits<int>::max();
-  int vmin = std::numeric_limits<int>::min();
-
-  for (std::size_t i=0; i<input.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
-
-    if (input.is_na[i]) {
-      output[i] = NA_INTEGER;
-    } else if (mp::isnan(input.data[i])) {
-      output[i] = NA_INTEGER;
-    } else if (input.data[i] < vmin || input.data[i] > vmax) {
-      output[i] = NA_INTEGER;
-    } else {
-      output[i] = static_cast<int>(input.data[i]);
+  int vmin = -vmax;
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (input.is_na[i] || mp::isnan(input.data[i])) {
+        output[i] = NA_INTEGER;
+        lossy[i] = FALSE;
+      } else if (input.data[i] < vmin || input.data[i] > vmax) {
+        output[i] = NA_INTEGER;
+        lossy[i] = TRUE;
+      } else {
+        output[i] = static_cast<int>(input.data[i]);
+        lossy[i] = FALSE;
+      }
     }
   }
 
-  return output;
+  return cast_result(output, lossy);
 }
 
 [[cpp11::register]]
-cpp11::doubles c_bigfloat_to_double(cpp11::strings x) {
+cpp11::list c_bigfloat_to_double(cpp11::strings x) {
   bigfloat_vector input(x);
   cpp11::writable::doubles output(input.size());
 
-  for (std::size_t i=0; i<input.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (input.is_na[i]) {
+        output[i] = NA_REAL;
+      } else {
+        output[i] = static_cast<double>(input.data[i]);
+      }
     }
+  }
 
-    if (input.is_na[i]) {
-      output[i] = NA_REAL;
-    } else {
-      output[i] = static_cast<double>(input.data[i]);
+  // lossless if the value survives R's decimal representation of the double
+  bigfloat_vector loopback(cpp11::strings(Rf_coerceVector(output, STRSXP)));
+  cpp11::writable::logicals lossy(input.size());
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (input.is_na[i] || mp::isnan(input.data[i])) {
+        lossy[i] = FALSE;
+      } else if (loopback.is_na[i] || mp::isnan(loopback.data[i])) {
+        lossy[i] = TRUE;
+      } else {
+        lossy[i] = loopback.data[i] != input.data[i] ? TRUE : FALSE;
+      }
     }
   }
 
-  return output;
+  return cast_result(output, lossy);
+}
+
+cpp11::list bigfloat_to_biginteger(const bigfloat_vector &input) {
+  biginteger_vector output(input.size());
+  cpp11::writable::logicals lossy(input.size());
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (input.is_na[i] || mp::isnan(input.data[i])) {
+        output.is_na[i] = true;
+        lossy[i] = FALSE;
+      } else if (mp::isinf(input.data[i])) {
+        output.is_na[i] = true;
+        lossy[i] = TRUE;
+      } else {
+        bigfloat_type rounded = mp::trunc(input.data[i]);
+        output.data[i] = biginteger_type(rounded);
+        lossy[i] = rounded != input.data[i] ? TRUE : FALSE;
+      }
+    }
+  }
+
+  return cast_result(output.encode(), lossy);
+}
+
+[[cpp11::register]]
+cpp11::list c_bigfloat_to_biginteger(cpp11::strings x) {
+  return bigfloat_to_biginteger(bigfloat_vector(x));
 }
 
 
@@ -109,12 +162,53 @@ cpp11::strings c_bigfloat_format(cpp11::strings x,
 }
 
 
+// Missing values and NaN. Lazy results are read from their values, so
+// their elements aren't formatted.
+[[cpp11::register]]
+cpp11::logicals c_bigfloat_is_na(cpp11::strings x) {
+  cpp11::writable::logicals output(x.size());
+
+  const bigfloat_sequence *seq = lazy_bigfloat_sequence(x);
+  const bigfloat_vector *values = NULL;
+  if (seq == NULL || !mp::isfinite(seq->start) || !mp::isfinite(seq->step)) {
+    values = lazy_bigfloat_values(x);
+  }
+
+  for (interrupt_blocks block(x.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (values != NULL) {
+        output[i] = values->is_na[i] || mp::isnan(values->data[i]);
+      } else if (seq != NULL) {
+        output[i] = false;
+      } else {
+        output[i] = x[i] == NA_STRING || std::strcmp(CHAR(x[i]), "NaN") == 0;
+      }
+    }
+  }
+
+  return output;
+}
+
+
 /*-------------------------*
  *  Comparison operations  *
  *-------------------------*/
 [[cpp11::register]]
 cpp11::integers c_bigfloat_compare(cpp11::strings lhs, cpp11::strings rhs, bool na_equal) {
-  return bignum_cmp(bigfloat_vector(lhs), bigfloat_vector(rhs), na_equal);
+  return bignum_cmp(bigfloat_batch(lhs), bigfloat_batch(rhs), na_equal);
+}
+
+// Comparison with a biginteger, double or integer vector, converting each
+// element as it is read. Returns NULL if an operand can't be converted
+// exactly, unless `allow_lossy`.
+[[cpp11::register]]
+SEXP c_bigfloat_compare_mixed(SEXP lhs, SEXP rhs, bool na_equal, bool allow_lossy) {
+  const bigfloat_operand x(lhs), y(rhs);
+  if (!allow_lossy && (x.lossy || y.lossy)) {
+    return R_NilValue;
+  }
+
+  return bignum_cmp(x, y, na_equal);
 }
 
 [[cpp11::register]]
@@ -128,26 +222,17 @@ cpp11::integers c_bigfloat_rank(cpp11::strings x) {
  *-------------------------*/
 [[cpp11::register]]
 cpp11::strings c_bigfloat_add(cpp11::strings lhs, cpp11::strings rhs) {
-  return binary_operation(
-    bigfloat_vector(lhs), bigfloat_vector(rhs),
-    [](const bigfloat_type &x, const bigfloat_type &y) { return x + y; }
-  ).encode();
+  return bigfloat_batch_add(bigfloat_batch(lhs), bigfloat_batch(rhs)).to_vector().encode();
 }
 
 [[cpp11::register]]
 cpp11::strings c_bigfloat_subtract(cpp11::strings lhs, cpp11::strings rhs) {
-  return binary_operation(
-    bigfloat_vector(lhs), bigfloat_vector(rhs),
-    [](const bigfloat_type &x, const bigfloat_type &y) { return x - y; }
-  ).encode();
+  return bigfloat_batch_subtract(bigfloat_batch(lhs), bigfloat_batch(rhs)).to_vector().encode();
 }
 
 [[cpp11::register]]
 cpp11::strings c_bigfloat_multiply(cpp11::strings lhs, cpp11::strings rhs) {
-  return binary_operation(
-    bigfloat_vector(lhs), bigfloat_vector(rhs),
-    [](const bigfloat_type &x, const bigfloat_type &y) { return x * y; }
-  ).encode();
+  return bigfloat_batch_multiply(bigfloat_batch(lhs), bigfloat_batch(rhs)).to_vector().encode();
 }
 
 [[cpp11::register]]
@@ -174,12 +259,52 @@ cpp11::strings c_bigfloat_modulo(cpp11::strings lhs, cpp11::strings rhs) {
   ).encode();
 }
 
+// Arithmetic between a bigfloat and a biginteger, double or integer vector,
+// converting each element as it is read. Returns NULL if an operand can't
+// be converted exactly (the caller's cast then reports the loss).
+[[cpp11::register]]
+SEXP c_bigfloat_arith_mixed(std::string op, SEXP lhs, SEXP rhs) {
+  const bigfloat_operand x(lhs), y(rhs);
+  if (x.lossy || y.lossy) {
+    return R_NilValue;
+  }
+
+  if (op == "+") {
+    return binary_operation(x, y, [](const bigfloat_type &a, const bigfloat_type &b) { return a + b; }).encode();
+  } else if (op == "-") {
+    return binary_operation(x, y, [](const bigfloat_type &a, const bigfloat_type &b) { return a - b; }).encode();
+  } else if (op == "*") {
+    return binary_operation(x, y, [](const bigfloat_type &a, const bigfloat_type &b) { return a * b; }).encode();
+  } else if (op == "/") {
+    return binary_operation(x, y, [](const bigfloat_type &a, const bigfloat_type &b) { return a / b; }).encode();
+  } else if (op == "^") {
+    return binary_operation(x, y, [](const bigfloat_type &a, const bigfloat_type &b) { return mp::pow(a, b); }).encode();
+  } else if (op == "%%") {
+    return binary_operation(x, y, [](const bigfloat_type &a, const bigfloat_type &b) { return mp::fmod(a, b); }).encode();
+  } else {
+    return R_NilValue; // # nocov
+  }
+}
+
 
 /*---------------------------*
  *  Mathematical operations  *
  *---------------------------*/
 [[cpp11::register]]
 cpp11::strings c_bigfloat_sum(cpp11::strings x, bool na_rm) {
+  // Compact sequences are added up without being materialized. The closed
+  // form rounds differently from adding the elements, so isn't used here.
+  const bigfloat_sequence *seq = lazy_bigfloat_sequence(x);
+  if (seq != NULL && mp::isfinite(seq->start) && mp::isfinite(seq->step)) {
+    bigfloat_type sum = 0;
+    for (interrupt_blocks block(seq->size); block.next(); ) {
+      for (std::size_t i=block.begin(); i<block.end(); ++i) {
+        sum += (*seq)[i];
+      }
+    }
+    return bigfloat_vector(1, sum).encode();
+  }
+
   return accumulate_operation(
     bigfloat_vector(x), bigfloat_vector(1, 0), na_rm,
     [](const bigfloat_type &a, const bigfloat_type &b) { return a + b; }
@@ -298,6 +423,25 @@ cpp11::strings c_bigfloat_log(cpp11::strings lhs) {
   ).encode();
 }
 
+[[cpp11::register]]
+cpp11::strings c_bigfloat_log_base(cpp11::strings lhs, cpp11::strings rhs) {
+  // The base is usually recycled, so its logarithm is reused
+  bool has_base = false;
+  bigfloat_type base, log_base;
+
+  return binary_operation(
+    bigfloat_vector(lhs), bigfloat_vector(rhs),
+    [&](const bigfloat_type &x, const bigfloat_type &y) {
+      if (!has_base || y != base) {
+        has_base = true;
+        base = y;
+        log_base = mp::log(y);
+      }
+      return bigfloat_type(mp::log(x) / log_base);
+    }
+  ).encode();
+}
+
 [[cpp11::register]]
 cpp11::strings c_bigfloat_log10(cpp11::strings lhs) {
   return unary_operation(
@@ -338,6 +482,14 @@ cpp11::strings c_bigfloat_cosh(cpp11::strings lhs) {
   ).encode();
 }
 
+[[cpp11::register]]
+cpp11::strings c_bigfloat_cospi(cpp11::strings lhs) {
+  return unary_operation(
+    bigfloat_vector(lhs),
+    [](const bigfloat_type &x) { return cos_pi(x); }
+  ).encode();
+}
+
 [[cpp11::register]]
 cpp11::strings c_bigfloat_sin(cpp11::strings lhs) {
   return unary_operation(
@@ -354,6 +506,14 @@ cpp11::strings c_bigfloat_sinh(cpp11::strings lhs) {
   ).encode();
 }
 
+[[cpp11::register]]
+cpp11::strings c_bigfloat_sinpi(cpp11::strings lhs) {
+  return unary_operation(
+    bigfloat_vector(lhs),
+    [](const bigfloat_type &x) { return sin_pi(x); }
+  ).encode();
+}
+
 [[cpp11::register]]
 cpp11::strings c_bigfloat_tan(cpp11::strings lhs) {
   return unary_operation(
@@ -370,6 +530,14 @@ cpp11::strings c_bigfloat_tanh(cpp11::strings lhs) {
   ).encode();
 }
 
+[[cpp11::register]]
+cpp11::strings c_bigfloat_tanpi(cpp11::strings lhs) {
+  return unary_operation(
+    bigfloat_vector(lhs),
+    [](const bigfloat_type &x) { return tan_pi(x); }
+  ).encode();
+}
+
 [[cpp11::register]]
 cpp11::strings c_bigfloat_acos(cpp11::strings lhs) {
   return unary_operation(
@@ -410,6 +578,14 @@ cpp11::strings c_bigfloat_atan(cpp11::strings lhs) {
   ).encode();
 }
 
+[[cpp11::register]]
+cpp11::strings c_bigfloat_atan2(cpp11::strings lhs, cpp11::strings rhs) {
+  return binary_operation(
+    bigfloat_vector(lhs), bigfloat_vector(rhs),
+    [](const bigfloat_type &y, const bigfloat_type &x) { return mp::atan2(y, x); }
+  ).encode();
+}
+
 [[cpp11::register]]
 cpp11::strings c_bigfloat_atanh(cpp11::strings lhs) {
   return unary_operation(
@@ -450,6 +626,116 @@ cpp11::strings c_bigfloat_trigamma(cpp11::strings lhs) {
   ).encode();
 }
 
+[[cpp11::register]]
+cpp11::strings c_bigfloat_hypot(cpp11::strings lhs, cpp11::strings rhs) {
+  return binary_operation(
+    bigfloat_vector(lhs), bigfloat_vector(rhs),
+    [](const bigfloat_type &x, const bigfloat_type &y) {
+      // Like C, an infinite side gives Inf even if the other is NaN
+      if (mp::isinf(x) || mp::isinf(y)) {
+        return std::numeric_limits<bigfloat_type>::infinity();
+      }
+      if (mp::isnan(x) || mp::isnan(y) || (x == 0 && y == 0)) {
+        return bigfloat_type(mp::abs(x) + mp::abs(y));
+      }
+
+      // Squares of huge or tiny values overflow or underflow, so both sides
+      // are scaled by the same power of two (which is exact) first
+      int exponent;
+      mp::frexp(mp::abs(x) > mp::abs(y) ? x : y, &exponent);
+      const bigfloat_type x_scaled = mp::ldexp(x, -exponent);
+      const bigfloat_type y_scaled = mp::ldexp(y, -exponent);
+      return bigfloat_type(mp::ldexp(mp::sqrt(x_scaled * x_scaled + y_scaled * y_scaled), exponent));
+    }
+  ).encode();
+}
+
+typedef mp::number<mp::cpp_bin_float<2 * std::numeric_limits<bigfloat_type>::digits, mp::digit_base_2> > fma_wide_type;
+
+// x * y + z, rounding once. The product is exact at twice the precision, and
+// the sum is rounded to odd there (rounding to nearest could settle on a
+// midpoint of bigfloat_type when z is below the wide precision). A sum
+// rounded to odd with at least two extra bits rounds correctly to
+// bigfloat_type.
+static bigfloat_type fused_multiply_add(const bigfloat_type &x, const bigfloat_type &y, const bigfloat_type &z) {
+  const fma_wide_type product = fma_wide_type(x) * fma_wide_type(y);
+  const fma_wide_type addend(z);
+  fma_wide_type sum = product + addend;
+
+  if (mp::isfinite(sum) && sum != 0) {
+    // Exact rounding error of the sum (Knuth's TwoSum)
+    const fma_wide_type rounded = sum - product;
+    const fma_wide_type error = (product - (sum - rounded)) + (addend - rounded);
+
+    // If inexact, the odd one of the two neighbours of the exact sum
+    typedef mp::number<fma_wide_type::backend_type::rep_type> wide_mantissa;
+    if (error != 0 && !mp::bit_test(wide_mantissa(sum.backend().bits()), 0)) {
+      sum = error > 0 ? boost::math::float_next(sum) : boost::math::float_prior(sum);
+    }
+  }
+
+  return bigfloat_type(sum);
+}
+
+[[cpp11::register]]
+cpp11::strings c_bigfloat_fma(cpp11::strings x, cpp11::strings y, cpp11::strings z) {
+  bigfloat_vector input_x(x), input_y(y), input_z(z);
+  if (input_x.size() != input_y.size() || input_x.size() != input_z.size()) {
+    cpp11::stop("Incompatible sizes"); // # nocov
+  }
+
+  bigfloat_vector output(input_x.size());
+
+  for (interrupt_blocks block(output.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (input_x.is_na[i] || input_y.is_na[i] || input_z.is_na[i]) {
+        output.is_na[i] = true;
+      } else {
+        output.data[i] = fused_multiply_add(input_x.data[i], input_y.data[i], input_z.data[i]);
+      }
+    }
+  }
+
+  return std::move(output).encode();
+}
+
+
+/*----------------------*
+ *  Summary statistics  *
+ *----------------------*/
+[[cpp11::register]]
+SEXP c_bigfloat_range(cpp11::strings x, bool na_rm) {
+  // Compact sequences have a closed form
+  const bigfloat_sequence *seq = lazy_bigfloat_sequence(x);
+  if (seq != NULL && seq->size > 0 && mp::isfinite(seq->start) && mp::isfinite(seq->step)) {
+    bigfloat_vector output(2);
+    output.data[0] = seq->min();
+    output.data[1] = seq->max();
+    return output.encode();
+  }
+
+  bigfloat_vector input(x);
+  return summary_range<bigfloat_vector>(summarise(input.data, input.is_na, na_rm, summary_extrema));
+}
+
+[[cpp11::register]]
+cpp11::strings c_bigfloat_mean(cpp11::strings x, bool na_rm) {
+  bigfloat_vector input(x);
+  return summary_mean(summarise(input.data, input.is_na, na_rm, summary_sum)).encode();
+}
+
+[[cpp11::register]]
+cpp11::strings c_bigfloat_var(cpp11::strings x, bool na_rm) {
+  bigfloat_vector input(x);
+  return summary_variance(summarise(input.data, input.is_na, na_rm, summary_moments)).encode();
+}
+
+[[cpp11::register]]
+cpp11::list c_bigfloat_summary(cpp11::strings x, bool na_rm) {
+  bigfloat_vector input(x);
+  return summary_list<bigfloat_vector>(summarise(input.data, input.is_na, na_rm, summary_all));
+}
+
 
 /*-----------------------*
  *  Sequence operations  *
@@ -477,13 +763,7 @@ cpp11::strings c_bigfloat_seq_to_by(const cpp11::strings& from,
 
   const std::size_t size = static_cast<std::size_t>(length_out);
 
-  bigfloat_vector output(size);
-
-  for (std::size_t i=0; i<size; ++i) {
-    output.data[i] = start + step * i;
-  }
-
-  return output.encode();
+  return encode_sequence(bigfloat_sequence(start, step, size));
 }
 
 [[cpp11::register]]
@@ -494,12 +774,9 @@ cpp11::strings c_bigfloat_seq_to_lo(const cpp11::strings& from,
   const bigfloat_type end = bigfloat_type(std::string(to[0]));
   const std::size_t size = length_out[0];
 
-  bigfloat_vector output(size);
-
   if (size == 1) {
     // Avoid division by zero
-    output.data[0] = start;
-    return output.encode();
+    return encode_sequence(bigfloat_sequence(start, 0, size));
   }
 
   const bigfloat_type num = end - start;
@@ -507,11 +784,7 @@ cpp11::strings c_bigfloat_seq_to_lo(const cpp11::strings& from,
 
   const bigfloat_type step = num / den;
 
-  for (std::size_t i=0; i<size; ++i) {
-    output.data[i] = start + step * i;
-  }
-
-  return output.encode();
+  return encode_sequence(bigfloat_sequence(start, step, size));
 }
 
 [[cpp11::register]]
@@ -522,11 +795,5 @@ cpp11::strings c_bigfloat_seq_by_lo(const cpp11::strings& from,
   const bigfloat_type step = bigfloat_type(std::string(by[0]));
   const std::size_t size = length_out[0];
 
-  bigfloat_vector output(size);
-
-  for (std::size_t i=0; i<size; ++i) {
-    output.data[i] = start + step * i;
-  }
-
-  return output.encode();
+  return encode_sequence(bigfloat_sequence(start, step, size));
 }
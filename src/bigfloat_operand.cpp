@@ -0,0 +1,72 @@
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include "bigfloat_operand.h"
+#include "fixed_width.h"
+#include "interrupt.h"
+
+
+bigfloat_operand::bigfloat_operand(SEXP x) : lossy(false) {
+  switch (TYPEOF(x)) {
+  case REALSXP:
+    kind = double_kind;
+    doubles = cpp11::doubles(x);
+    is_na.resize(doubles.size());
+    for (R_xlen_t i=0; i<doubles.size(); ++i) {
+      is_na[i] = ISNA(doubles[i]);
+    }
+    break;
+
+  case INTSXP:
+    kind = integer_kind;
+    ints = cpp11::integers(x);
+    is_na.resize(ints.size());
+    for (R_xlen_t i=0; i<ints.size(); ++i) {
+      is_na[i] = ints[i] == NA_INTEGER;
+    }
+    break;
+
+  default:
+    if (Rf_inherits(x, "bignum_biginteger")) {
+      kind = biginteger_kind;
+      integers = biginteger_vector(cpp11::strings(x));
+      is_na = integers.is_na;
+
+      // Values wider than the significand may be rounded
+      const std::size_t digits = std::numeric_limits<bigfloat_type>::digits;
+      for (interrupt_blocks block(size()); !lossy && block.next(); ) {
+        for (std::size_t i=block.begin(); i<block.end(); ++i) {
+          if (!is_na[i] && bit_width(integers.data[i]) > digits &&
+              biginteger_type(bigfloat_type(integers.data[i])) != integers.data[i]) {
+            lossy = true;
+            break;
+          }
+        }
+      }
+    } else {
+      kind = bigfloat_kind;
+      floats = bigfloat_vector(cpp11::strings(x));
+      is_na = floats.is_na;
+    }
+  }
+}
+
+bigfloat_type bigfloat_operand::double_value(double x) {
+  // Integers of up to 15 digits are their own decimal representation
+  // (including -0, which as.character() writes as "0")
+  if (x == std::trunc(x) && std::fabs(x) < 1e15) {
+    return x == 0 ? bigfloat_type(0) : bigfloat_type(x);
+  }
+  if (std::isnan(x)) {
+    return std::numeric_limits<bigfloat_type>::quiet_NaN();
+  }
+  if (std::isinf(x)) {
+    return bigfloat_type(x);
+  }
+
+  char buffer[32];
+  const int n = std::snprintf(buffer, sizeof(buffer), "%.15g", x);
+  bigfloat_type output;
+  parse_bigfloat(buffer, buffer + n, output);
+  return output;
+}
@@ -0,0 +1,81 @@
+#ifndef __BIGFLOAT_OPERAND__
+#define __BIGFLOAT_OPERAND__
+
+#include <vector>
+#include <cpp11.hpp>
+#include "bigfloat_vector.h"
+#include "biginteger_vector.h"
+#include "operations.h"
+
+/*
+ * An operand of a bigfloat kernel, which may be a bigfloat, biginteger,
+ * double or integer vector.
+ *
+ * Mixed-type arithmetic and comparison would otherwise cast one operand to a
+ * whole bigfloat vector first (formatting every element as a string, then
+ * parsing it again). Here, each element is converted as the kernel reads
+ * it, with the same result as the cast:
+ *   - doubles are rounded to 15 significant digits, like as.character(),
+ *   - biginteger values are rounded to the nearest bigfloat, and `lossy` is
+ *     set if any value isn't represented exactly.
+ */
+class bigfloat_operand {
+public:
+  enum kind_type { bigfloat_kind, biginteger_kind, double_kind, integer_kind };
+
+  kind_type kind;
+  bigfloat_vector floats;
+  biginteger_vector integers;
+  cpp11::doubles doubles;
+  cpp11::integers ints;
+  std::vector<bool> is_na;
+  bool lossy;
+  std::size_t size() const { return is_na.size(); }
+
+
+  explicit bigfloat_operand(SEXP x);
+
+  // Element `i` (not NA) as a bigfloat
+  bigfloat_type value(std::size_t i) const {
+    switch (kind) {
+    case bigfloat_kind:
+      return floats.data[i];
+    case biginteger_kind:
+      return bigfloat_type(integers.data[i]);
+    case double_kind:
+      return double_value(doubles[i]);
+    default:
+      return bigfloat_type(ints[i]);
+    }
+  }
+
+private:
+  static bigfloat_type double_value(double x);
+};
+
+template<>
+class element_reader<bigfloat_operand> {
+  const bigfloat_operand &x;
+
+public:
+  explicit element_reader(const bigfloat_operand &x) : x(x) {}
+  bigfloat_type operator()(std::size_t i) const { return x.value(i); }
+};
+
+template<>
+struct kernel_result<bigfloat_operand> {
+  typedef bigfloat_vector type;
+};
+
+inline int compare_elements(const bigfloat_operand &lhs, const bigfloat_operand &rhs, std::size_t i) {
+  const bigfloat_type x = lhs.value(i), y = rhs.value(i);
+  if (x < y) {
+    return -1;
+  } else if (x > y) {
+    return 1;
+  } else {
+    return 0;
+  }
+}
+
+#endif
@@ -1,28 +1,44 @@
 #include "bigfloat_vector.h"
 #include "format.h"
+#include "cache.h"
+#include "interrupt.h"
+#include "altrep.h"
 
 
 bigfloat_vector::bigfloat_vector(cpp11::strings x) : bigfloat_vector(x.size()) {
-  std::size_t vsize = x.size();
-  for (std::size_t i=0; i<vsize; ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
+  // values of a lazy result don't need parsing
+  const bigfloat_vector *lazy = lazy_bigfloat_values(x);
+  if (lazy != NULL) {
+    *this = *lazy;
+    return;
+  }
 
-    if (x[i] == NA_STRING || x[i].size() == 0) {
-      is_na[i] = true;
-    } else {
-      try {
-        data[i] = bigfloat_type(std::string(x[i]));
-      } catch (...) {
+  std::size_t vsize = x.size();
+  parse_cache cache(vsize);
+  for (interrupt_blocks block(vsize); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      std::size_t first;
+      if (x[i] == NA_STRING) {
         is_na[i] = true;
+      } else if (cache.find(x[i], i, first)) {
+        data[i] = data[first];
+        is_na[i] = is_na[first];
+      } else {
+        const char *str = CHAR(x[i]);
+        is_na[i] = !parse_bigfloat(str, str + x[i].size(), data[i]);
       }
     }
   }
 }
 
 
-cpp11::strings bigfloat_vector::encode() const {
+cpp11::strings bigfloat_vector::encode() const & {
+#ifdef BIGNUM_ALTREP
+  if (use_lazy_encoding(size())) {
+    return bigfloat_vector(*this).encode();
+  }
+#endif
+
   cpp11::writable::strings output = format_bigfloat_vector(
     *this,
     bignum_format_dec,
@@ -33,3 +49,15 @@ cpp11::strings bigfloat_vector::encode() const {
   output.attr("class") = {"bignum_bigfloat", "bignum_vctr", "vctrs_vctr"};
   return output;
 }
+
+cpp11::strings bigfloat_vector::encode() && {
+#ifdef BIGNUM_ALTREP
+  if (use_lazy_encoding(size())) {
+    cpp11::sexp output(new_lazy_strings(std::move(*this)));
+    output.attr("class") = {"bignum_bigfloat", "bignum_vctr", "vctrs_vctr"};
+    return cpp11::strings(output);
+  }
+#endif
+
+  return static_cast<const bigfloat_vector&>(*this).encode();
+}
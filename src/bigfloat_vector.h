@@ -20,7 +20,13 @@ public:
 
   bigfloat_vector(cpp11::strings x);
 
-  cpp11::strings encode() const;
+  // Formatted as a classed character vector. Large results are returned
+  // lazily (see altrep.h), taking over the values of a temporary.
+  cpp11::strings encode() const &;
+  cpp11::strings encode() &&;
 };
 
+// Correctly rounded conversion (see parse_bigfloat.cpp), false if invalid
+bool parse_bigfloat(const char *first, const char *last, bigfloat_type &value);
+
 #endif
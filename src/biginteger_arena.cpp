@@ -0,0 +1,124 @@
+#include <climits>
+#include "biginteger_arena.h"
+#include "cache.h"
+#include "interrupt.h"
+#include "altrep.h"
+
+/*
+ * Plain decimal strings are accumulated into the scratch value in place, so
+ * its storage is reused from one element to the next. Anything else (hex,
+ * negative values with leading zeros, malformed input) goes through
+ * parse_biginteger(), so both parsers accept the same strings.
+ */
+static bool parse_in_place(const char *first, const char *last, biginteger_type &value) {
+  const bool negative = first != last && *first == '-';
+  const char *p = negative ? first + 1 : first;
+  if (p == last || (negative && *p == '0' && last - p > 1)) {
+    return parse_biginteger(first, last, value);
+  }
+  for (const char *q=p; q!=last; ++q) {
+    if (*q < '0' || *q > '9') {
+      return parse_biginteger(first, last, value);
+    }
+  }
+
+  // The first chunk has up to 19 digits, so the others have exactly 19
+  typedef boost::multiprecision::limb_type limb_type;
+  const limb_type chunk_scale = 10000000000000000000ULL;
+  const std::size_t chunk_digits = 19;
+
+  const char *chunk_last = p + ((last - p - 1) % chunk_digits + 1);
+  limb_type chunk = 0;
+  for (; p != chunk_last; ++p) {
+    chunk = chunk * 10 + (*p - '0');
+  }
+  value = chunk;
+
+  while (p != last) {
+    chunk = 0;
+    for (chunk_last = p + chunk_digits; p != chunk_last; ++p) {
+      chunk = chunk * 10 + (*p - '0');
+    }
+    value *= chunk_scale;
+    value += chunk;
+  }
+  if (negative) {
+    value.backend().negate();
+  }
+  return true;
+}
+
+biginteger_arena::biginteger_arena(const biginteger_vector &x) : biginteger_arena(x.size()) {
+  std::size_t n_limbs = 0;
+  for (std::size_t i=0; i<x.size(); ++i) {
+    n_limbs += x.is_na[i] ? 0 : x.data[i].backend().size();
+  }
+  limbs.reserve(n_limbs);
+
+  for (interrupt_blocks block(x.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (x.is_na[i]) {
+        is_na[i] = true;
+      } else {
+        assign(i, x.data[i]);
+      }
+    }
+  }
+}
+
+biginteger_arena::biginteger_arena(cpp11::strings x) : biginteger_arena(x.size()) {
+  // values of a lazy result don't need parsing
+  const biginteger_vector *lazy = lazy_biginteger_values(x);
+  if (lazy != NULL) {
+    *this = biginteger_arena(*lazy);
+    return;
+  }
+
+  // Upper bound on the limbs needed (hexadecimal digits are 4 bits each, so
+  // every input needs at most 4 bits per character)
+  const std::size_t limb_bits = sizeof(limb_type) * CHAR_BIT;
+  std::size_t n_limbs = 0;
+  for (R_xlen_t i=0; i<x.size(); ++i) {
+    if (x[i] != NA_STRING) {
+      n_limbs += (x[i].size() * 4) / limb_bits + 1;
+    }
+  }
+  limbs.reserve(n_limbs);
+
+  std::size_t vsize = x.size();
+  parse_cache cache(vsize);
+  biginteger_type scratch;
+  for (interrupt_blocks block(vsize); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      std::size_t first;
+      if (x[i] == NA_STRING) {
+        is_na[i] = true;
+      } else if (cache.find(x[i], i, first)) {
+        share(i, first);
+      } else {
+        const char *str = CHAR(x[i]);
+        if (parse_in_place(str, str + x[i].size(), scratch)) {
+          assign(i, scratch);
+        } else {
+          is_na[i] = true;
+        }
+      }
+    }
+  }
+}
+
+biginteger_vector biginteger_arena::to_vector() const {
+  biginteger_vector output(size());
+
+  for (interrupt_blocks block(size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (is_na[i]) {
+        output.is_na[i] = true;
+      } else {
+        load(i, output.data[i]);
+      }
+    }
+  }
+
+  return output;
+}
@@ -0,0 +1,135 @@
+#ifndef __BIGINTEGER_ARENA__
+#define __BIGINTEGER_ARENA__
+
+#include <vector>
+#include <cpp11.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include "biginteger_vector.h"
+#include "operations.h"
+
+/*
+ * Biginteger values stored as a structure of arrays.
+ *
+ * In a biginteger_vector, every value wider than the inline limbs owns a
+ * separate heap block. Here, the limbs of all values share one contiguous
+ * buffer, and each element records the offset and length of its limbs and
+ * its sign. Building or destroying a vector costs a handful of allocations,
+ * whatever its size, and kernels walk memory in order.
+ *
+ * Limbs are stored least significant first, without leading zero limbs (so
+ * zero has length 0). Elements with equal values may share their limbs.
+ *
+ * Values are immutable once stored. Kernels either compare limbs directly
+ * (see compare.h) or load each element into a reused scratch value (see
+ * element_reader in operations.h).
+ */
+class biginteger_arena {
+public:
+  typedef boost::multiprecision::limb_type limb_type;
+
+  std::vector<limb_type> limbs;
+  std::vector<std::size_t> offset;
+  std::vector<std::size_t> length;
+  std::vector<bool> sign;
+  std::vector<bool> is_na;
+  std::size_t size() const { return offset.size(); }
+
+
+  explicit biginteger_arena(std::size_t count = 0)
+    : offset(count, 0), length(count, 0), sign(count, false), is_na(count, false) {}
+
+  explicit biginteger_arena(const biginteger_vector &x);
+  biginteger_arena(cpp11::strings x);
+
+  // Appends the limbs of `value` as element `i`
+  void assign(std::size_t i, const biginteger_type &value) {
+    const std::size_t n_limbs = value.backend().size();
+    const limb_type *first = value.backend().limbs();
+
+    offset[i] = limbs.size();
+    length[i] = n_limbs == 1 && first[0] == 0 ? 0 : n_limbs;
+    sign[i] = value.backend().sign();
+    limbs.insert(limbs.end(), first, first + length[i]);
+  }
+
+  // Element `i` refers to the limbs of element `first`
+  void share(std::size_t i, std::size_t first) {
+    offset[i] = offset[first];
+    length[i] = length[first];
+    sign[i] = sign[first];
+    is_na[i] = is_na[first];
+  }
+
+  // Loads element `i` into `value`, reusing its storage
+  void load(std::size_t i, biginteger_type &value) const {
+    if (length[i] == 0) {
+      value = 0;
+      return;
+    }
+
+    const limb_type *first = limbs.data() + offset[i];
+    value.backend().resize(length[i], length[i]);
+    std::copy(first, first + length[i], value.backend().limbs());
+    value.backend().sign(sign[i]);
+    value.backend().normalize();
+  }
+
+  biginteger_type value(std::size_t i) const {
+    biginteger_type output;
+    load(i, output);
+    return output;
+  }
+
+  // Three-way comparison of element `i` with element `j` of `rhs` (not NA)
+  int compare(std::size_t i, const biginteger_arena &rhs, std::size_t j) const {
+    const bool lhs_negative = sign[i] && length[i] > 0;
+    const bool rhs_negative = rhs.sign[j] && rhs.length[j] > 0;
+    if (lhs_negative != rhs_negative) {
+      return lhs_negative ? -1 : 1;
+    }
+
+    int magnitude = 0;
+    if (length[i] != rhs.length[j]) {
+      magnitude = length[i] < rhs.length[j] ? -1 : 1;
+    } else {
+      const limb_type *x = limbs.data() + offset[i];
+      const limb_type *y = rhs.limbs.data() + rhs.offset[j];
+      for (std::size_t k=length[i]; k>0; --k) {
+        if (x[k - 1] != y[k - 1]) {
+          magnitude = x[k - 1] < y[k - 1] ? -1 : 1;
+          break;
+        }
+      }
+    }
+
+    return lhs_negative ? -magnitude : magnitude;
+  }
+
+  biginteger_vector to_vector() const;
+};
+
+// Kernels load each element into a scratch value, reused between elements
+template<>
+class element_reader<biginteger_arena> {
+  const biginteger_arena &x;
+  mutable biginteger_type scratch;
+
+public:
+  explicit element_reader(const biginteger_arena &x) : x(x) {}
+  const biginteger_type& operator()(std::size_t i) const {
+    x.load(i, scratch);
+    return scratch;
+  }
+};
+
+template<>
+struct kernel_result<biginteger_arena> {
+  typedef biginteger_vector type;
+};
+
+// Comparisons read limbs directly
+inline int compare_elements(const biginteger_arena &lhs, const biginteger_arena &rhs, std::size_t i) {
+  return lhs.compare(i, rhs, i);
+}
+
+#endif
@@ -1,8 +1,23 @@
 #include <cpp11.hpp>
 #include "biginteger_vector.h"
+#include "biginteger_arena.h"
+#include "biginteger_text.h"
+#include "bigfloat_vector.h"
 #include "operations.h"
 #include "compare.h"
 #include "format.h"
+#include "cast.h"
+#include "interrupt.h"
+#include "fixed_width.h"
+#include "multiply.h"
+#include "bitwise.h"
+#include "primes.h"
+#include "roots.h"
+#include "combinatorics.h"
+#include "summary.h"
+#include "parallel.h"
+#include "sequence.h"
+#include "altrep.h"
 
 namespace mp = boost::multiprecision;
 
@@ -16,68 +31,103 @@ cpp11::strings c_biginteger(cpp11::strings x) {
  *  Casting  *
  *-----------*/
 [[cpp11::register]]
-cpp11::logicals c_biginteger_to_logical(cpp11::strings x) {
+cpp11::list c_biginteger_to_logical(cpp11::strings x) {
   biginteger_vector input(x);
   cpp11::writable::logicals output(input.size());
-
-  for (std::size_t i=0; i<input.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
-
-    if (input.is_na[i]) {
-      output[i] = NA_LOGICAL;
-    } else {
-      output[i] = input.data[i] == 0 ? FALSE : TRUE;
+  cpp11::writable::logicals lossy(input.size());
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (input.is_na[i]) {
+        output[i] = NA_LOGICAL;
+        lossy[i] = FALSE;
+      } else {
+        output[i] = input.data[i] == 0 ? FALSE : TRUE;
+        lossy[i] = input.data[i] == 0 || input.data[i] == 1 ? FALSE : TRUE;
+      }
     }
   }
 
-  return output;
+  return cast_result(output, lossy);
 }
 
 [[cpp11::register]]
-cpp11::integers c_biginteger_to_integer(cpp11::strings x) {
+cpp11::list c_biginteger_to_integer(cpp11::strings x) {
   biginteger_vector input(x);
   cpp11::writable::integers output(input.size());
+  cpp11::writable::logicals lossy(input.size());
 
+  // INT_MIN is NA_integer_
   int vmax = std::numeric_limits<int>::max();
-  int vmin = std::numeric_limits<int>::min();
-
-  for (std::size_t i=0; i<input.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
-
-    if (input.is_na[i]) {
-      output[i] = NA_INTEGER;
-    } else if (input.data[i] < vmin || input.data[i] > vmax) {
-      output[i] = NA_INTEGER;
-    } else {
-      output[i] = static_cast<int>(input.data[i]);
+  int vmin = -vmax;
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (input.is_na[i]) {
+        output[i] = NA_INTEGER;
+        lossy[i] = FALSE;
+      } else if (input.data[i] < vmin || input.data[i] > vmax) {
+        output[i] = NA_INTEGER;
+        lossy[i] = TRUE;
+      } else {
+        output[i] = static_cast<int>(input.data[i]);
+        lossy[i] = FALSE;
+      }
     }
   }
 
-  return output;
+  return cast_result(output, lossy);
 }
 
 [[cpp11::register]]
-cpp11::doubles c_biginteger_to_double(cpp11::strings x) {
+cpp11::list c_biginteger_to_double(cpp11::strings x) {
   biginteger_vector input(x);
   cpp11::writable::doubles output(input.size());
-
-  for (std::size_t i=0; i<input.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
+  cpp11::writable::logicals lossy(input.size());
+
+  // integers beyond 2^53 can't all be represented
+  const biginteger_type vmax = biginteger_type(1) << std::numeric_limits<double>::digits;
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (input.is_na[i]) {
+        output[i] = NA_REAL;
+        lossy[i] = FALSE;
+      } else {
+        output[i] = static_cast<double>(input.data[i]);
+        lossy[i] = mp::abs(input.data[i]) >= vmax ? TRUE : FALSE;
+      }
     }
+  }
+
+  return cast_result(output, lossy);
+}
 
-    if (input.is_na[i]) {
-      output[i] = NA_REAL;
-    } else {
-      output[i] = static_cast<double>(input.data[i]);
+[[cpp11::register]]
+cpp11::list c_biginteger_to_bigfloat(cpp11::strings x) {
+  biginteger_vector input(x);
+  bigfloat_vector output(input.size());
+  cpp11::writable::logicals lossy(input.size());
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (input.is_na[i]) {
+        output.is_na[i] = true;
+        lossy[i] = FALSE;
+      } else {
+        output.data[i] = bigfloat_type(input.data[i]);
+        lossy[i] = biginteger_type(output.data[i]) != input.data[i] ? TRUE : FALSE;
+      }
     }
   }
 
-  return output;
+  return cast_result(output.encode(), lossy);
+}
+
+[[cpp11::register]]
+cpp11::list c_biginteger_from_double(cpp11::doubles x) {
+  // use R's decimal representation, as for biginteger(as.character(x))
+  return bigfloat_to_biginteger(bigfloat_vector(cpp11::strings(Rf_coerceVector(x, STRSXP))));
 }
 
 
@@ -102,7 +152,19 @@ cpp11::strings c_biginteger_format(cpp11::strings x, cpp11::strings notation) {
  *-------------------------*/
 [[cpp11::register]]
 cpp11::integers c_biginteger_compare(cpp11::strings lhs, cpp11::strings rhs, bool na_equal) {
-  return bignum_cmp(biginteger_vector(lhs), biginteger_vector(rhs), na_equal);
+  // lazy results hold parsed values, but would have to be formatted as text
+  if (lazy_biginteger_values(lhs) != NULL || lazy_biginteger_values(rhs) != NULL) {
+    return bignum_cmp(biginteger_arena(lhs), biginteger_arena(rhs), na_equal);
+  }
+  return bignum_cmp(biginteger_text(lhs), biginteger_text(rhs), na_equal);
+}
+
+[[cpp11::register]]
+cpp11::logicals c_biginteger_equal(cpp11::strings lhs, cpp11::strings rhs, bool na_equal) {
+  if (lazy_biginteger_values(lhs) != NULL || lazy_biginteger_values(rhs) != NULL) {
+    return bignum_equal(biginteger_arena(lhs), biginteger_arena(rhs), na_equal);
+  }
+  return bignum_equal(biginteger_text(lhs), biginteger_text(rhs), na_equal);
 }
 
 [[cpp11::register]]
@@ -116,58 +178,164 @@ cpp11::integers c_biginteger_rank(cpp11::strings x) {
  *-------------------------*/
 [[cpp11::register]]
 cpp11::strings c_biginteger_add(cpp11::strings lhs, cpp11::strings rhs) {
-  return binary_operation(
-    biginteger_vector(lhs), biginteger_vector(rhs),
-    [](const biginteger_type &x, const biginteger_type &y) { return x + y; }
+  return binary_operation_in_place(
+    biginteger_arena(lhs), biginteger_arena(rhs),
+    [](biginteger_type &out, const biginteger_type &x, const biginteger_type &y) { out = x + y; }
   ).encode();
 }
 
 [[cpp11::register]]
 cpp11::strings c_biginteger_subtract(cpp11::strings lhs, cpp11::strings rhs) {
-  return binary_operation(
-    biginteger_vector(lhs), biginteger_vector(rhs),
-    [](const biginteger_type &x, const biginteger_type &y) { return x - y; }
+  return binary_operation_in_place(
+    biginteger_arena(lhs), biginteger_arena(rhs),
+    [](biginteger_type &out, const biginteger_type &x, const biginteger_type &y) { out = x - y; }
   ).encode();
 }
 
 [[cpp11::register]]
 cpp11::strings c_biginteger_multiply(cpp11::strings lhs, cpp11::strings rhs) {
-  return binary_operation(
-    biginteger_vector(lhs), biginteger_vector(rhs),
-    [](const biginteger_type &x, const biginteger_type &y) { return x * y; }
+  return binary_operation_in_place(
+    biginteger_arena(lhs), biginteger_arena(rhs),
+    [](biginteger_type &out, const biginteger_type &x, const biginteger_type &y) { out = fast_multiply(x, y); }
   ).encode();
 }
 
 [[cpp11::register]]
 cpp11::strings c_biginteger_pow(cpp11::strings lhs, cpp11::integers rhs) {
+  return fixed_width_operation(biginteger_vector(lhs), rhs, fixed_width_pow()).encode();
+}
+
+[[cpp11::register]]
+cpp11::strings c_biginteger_modulo(cpp11::strings lhs, cpp11::strings rhs) {
+  return binary_operation_in_place(
+    biginteger_arena(lhs), biginteger_arena(rhs),
+    [](biginteger_type &out, const biginteger_type &x, const biginteger_type &y) { out = fast_remainder(x, y); }
+  ).encode();
+}
+
+[[cpp11::register]]
+cpp11::strings c_biginteger_quotient(cpp11::strings lhs, cpp11::strings rhs) {
+  return binary_operation_in_place(
+    biginteger_arena(lhs), biginteger_arena(rhs),
+    [](biginteger_type &out, const biginteger_type &x, const biginteger_type &y) { out = fast_quotient(x, y); }
+  ).encode();
+}
+
+
+/*----------------------*
+ *  Bitwise operations  *
+ *----------------------*/
+[[cpp11::register]]
+cpp11::strings c_biginteger_bitwAnd(cpp11::strings lhs, cpp11::strings rhs) {
   return binary_operation(
-    biginteger_vector(lhs), rhs,
-    [](const biginteger_type &x, int y) { return mp::pow(x, y); }
+    biginteger_vector(lhs), biginteger_vector(rhs),
+    [](const biginteger_type &x, const biginteger_type &y) { return bitwise_operation(x, y, bitwise_and()); }
   ).encode();
 }
 
 [[cpp11::register]]
-cpp11::strings c_biginteger_modulo(cpp11::strings lhs, cpp11::strings rhs) {
+cpp11::strings c_biginteger_bitwOr(cpp11::strings lhs, cpp11::strings rhs) {
   return binary_operation(
     biginteger_vector(lhs), biginteger_vector(rhs),
-    [](const biginteger_type &x, const biginteger_type &y) { return x % y; }
+    [](const biginteger_type &x, const biginteger_type &y) { return bitwise_operation(x, y, bitwise_or()); }
   ).encode();
 }
 
 [[cpp11::register]]
-cpp11::strings c_biginteger_quotient(cpp11::strings lhs, cpp11::strings rhs) {
+cpp11::strings c_biginteger_bitwXor(cpp11::strings lhs, cpp11::strings rhs) {
   return binary_operation(
     biginteger_vector(lhs), biginteger_vector(rhs),
-    [](const biginteger_type &x, const biginteger_type &y) { return x / y; }
+    [](const biginteger_type &x, const biginteger_type &y) { return bitwise_operation(x, y, bitwise_xor()); }
+  ).encode();
+}
+
+[[cpp11::register]]
+cpp11::strings c_biginteger_bitwNot(cpp11::strings x) {
+  return unary_operation(
+    biginteger_vector(x),
+    [](const biginteger_type &x) { return bitwise_not(x); }
+  ).encode();
+}
+
+[[cpp11::register]]
+cpp11::strings c_biginteger_bitwShiftL(cpp11::strings lhs, cpp11::integers rhs) {
+  return binary_operation(
+    biginteger_vector(lhs), rhs,
+    [](const biginteger_type &x, int n) { return shift_left(x, n); }
   ).encode();
 }
 
+[[cpp11::register]]
+cpp11::strings c_biginteger_bitwShiftR(cpp11::strings lhs, cpp11::integers rhs) {
+  return binary_operation(
+    biginteger_vector(lhs), rhs,
+    [](const biginteger_type &x, int n) { return shift_right(x, n); }
+  ).encode();
+}
+
+[[cpp11::register]]
+cpp11::integers c_biginteger_popcount(cpp11::strings x) {
+  biginteger_vector input(x);
+  cpp11::writable::integers output(input.size());
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      int count;
+      output[i] = !input.is_na[i] && popcount(input.data[i], count) ? count : NA_INTEGER;
+    }
+  }
+
+  return output;
+}
+
+[[cpp11::register]]
+cpp11::integers c_biginteger_bitlength(cpp11::strings x) {
+  biginteger_vector input(x);
+  cpp11::writable::integers output(input.size());
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      output[i] = input.is_na[i] ? NA_INTEGER : static_cast<int>(bit_width(input.data[i]));
+    }
+  }
+
+  return output;
+}
+
+[[cpp11::register]]
+cpp11::logicals c_biginteger_testbit(cpp11::strings lhs, cpp11::integers rhs) {
+  biginteger_vector input(lhs);
+  if (input.size() != static_cast<std::size_t>(rhs.size())) {
+    cpp11::stop("Incompatible sizes"); // # nocov
+  }
+
+  cpp11::writable::logicals output(input.size());
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (input.is_na[i] || rhs[i] == NA_INTEGER || rhs[i] < 0) {
+        output[i] = NA_LOGICAL;
+      } else {
+        output[i] = test_bit(input.data[i], rhs[i]) ? TRUE : FALSE;
+      }
+    }
+  }
+
+  return output;
+}
+
 
 /*---------------------------*
  *  Mathematical operations  *
  *---------------------------*/
 [[cpp11::register]]
 cpp11::strings c_biginteger_sum(cpp11::strings x, bool na_rm) {
+  // Compact sequences have a closed form
+  const biginteger_sequence *seq = lazy_biginteger_sequence(x);
+  if (seq != NULL) {
+    return biginteger_vector(1, seq->sum()).encode();
+  }
+
   return accumulate_operation(
     biginteger_vector(x), biginteger_vector(1, 0), na_rm,
     [](const biginteger_type &a, const biginteger_type &b) { return a + b; }
@@ -178,7 +346,7 @@ cpp11::strings c_biginteger_sum(cpp11::strings x, bool na_rm) {
 cpp11::strings c_biginteger_prod(cpp11::strings x, bool na_rm) {
   return accumulate_operation(
     biginteger_vector(x), biginteger_vector(1, 1), na_rm,
-    [](const biginteger_type &a, const biginteger_type &b) { return a * b; }
+    [](const biginteger_type &a, const biginteger_type &b) { return fast_multiply(a, b); }
   ).encode();
 }
 
@@ -194,7 +362,7 @@ cpp11::strings c_biginteger_cumsum(cpp11::strings x) {
 cpp11::strings c_biginteger_cumprod(cpp11::strings x) {
   return partial_accumulate_operation(
     biginteger_vector(x),
-    [](const biginteger_type &a, const biginteger_type &b) { return a * b; }
+    [](const biginteger_type &a, const biginteger_type &b) { return fast_multiply(a, b); }
   ).encode();
 }
 
@@ -231,6 +399,245 @@ cpp11::strings c_biginteger_sign(cpp11::strings lhs) {
 }
 
 
+/*----------------------*
+ *  Summary statistics  *
+ *----------------------*/
+[[cpp11::register]]
+SEXP c_biginteger_range(cpp11::strings x, bool na_rm) {
+  // Compact sequences have a closed form
+  const biginteger_sequence *seq = lazy_biginteger_sequence(x);
+  if (seq != NULL && seq->size > 0) {
+    biginteger_vector output(2);
+    output.data[0] = seq->min();
+    output.data[1] = seq->max();
+    return output.encode();
+  }
+
+  biginteger_vector input(x);
+  return summary_range<biginteger_vector>(summarise(input.data, input.is_na, na_rm, summary_extrema));
+}
+
+[[cpp11::register]]
+cpp11::strings c_biginteger_mean(cpp11::strings x, bool na_rm) {
+  const biginteger_sequence *seq = lazy_biginteger_sequence(x);
+  if (seq != NULL && seq->size > 0) {
+    return bigfloat_vector(1, bigfloat_type(seq->sum()) / seq->size).encode();
+  }
+
+  biginteger_vector input(x);
+  return summary_mean(summarise(input.data, input.is_na, na_rm, summary_sum)).encode();
+}
+
+[[cpp11::register]]
+cpp11::strings c_biginteger_var(cpp11::strings x, bool na_rm) {
+  biginteger_vector input(x);
+  return summary_variance(summarise(input.data, input.is_na, na_rm, summary_moments)).encode();
+}
+
+[[cpp11::register]]
+cpp11::list c_biginteger_summary(cpp11::strings x, bool na_rm) {
+  biginteger_vector input(x);
+  return summary_list<biginteger_vector>(summarise(input.data, input.is_na, na_rm, summary_all));
+}
+
+
+/*-----------------*
+ *  Integer roots  *
+ *-----------------*/
+[[cpp11::register]]
+cpp11::strings c_biginteger_isqrt(cpp11::strings x) {
+  return unary_operation(
+    biginteger_vector(x),
+    [](const biginteger_type &x) { return integer_root(x, 2); }
+  ).encode();
+}
+
+[[cpp11::register]]
+cpp11::strings c_biginteger_iroot(cpp11::strings lhs, cpp11::integers rhs) {
+  return binary_operation(
+    biginteger_vector(lhs), rhs,
+    [](const biginteger_type &x, int n) { return integer_root(x, n); }
+  ).encode();
+}
+
+template<class Predicate>
+cpp11::logicals biginteger_predicate(const biginteger_vector &input, const Predicate &predicate) {
+  cpp11::writable::logicals output(input.size());
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (input.is_na[i]) {
+        output[i] = NA_LOGICAL;
+      } else {
+        output[i] = predicate(input.data[i]) ? TRUE : FALSE;
+      }
+    }
+  }
+
+  return output;
+}
+
+[[cpp11::register]]
+cpp11::logicals c_biginteger_is_square(cpp11::strings x) {
+  return biginteger_predicate(
+    biginteger_vector(x),
+    [](const biginteger_type &x) { return is_square(x); }
+  );
+}
+
+[[cpp11::register]]
+cpp11::logicals c_biginteger_is_perfect_power(cpp11::strings x) {
+  return biginteger_predicate(
+    biginteger_vector(x),
+    [](const biginteger_type &x) { return is_perfect_power(x); }
+  );
+}
+
+
+/*-----------------*
+ *  Combinatorics  *
+ *-----------------*/
+[[cpp11::register]]
+cpp11::strings c_biginteger_factorial(cpp11::integers x) {
+  biginteger_vector output(x.size());
+  recent_results<int> memo;
+
+  for (interrupt_blocks block(output.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      const int n = x[i];
+      if (n == NA_INTEGER || n < 0) {
+        output.is_na[i] = true;
+        continue;
+      }
+
+      // Continue from the largest factorial already computed
+      const std::pair<const int, biginteger_type> *previous = memo.find_at_most(n);
+      if (previous == NULL) {
+        output.data[i] = factorial(n);
+      } else if (previous->first == n) {
+        output.data[i] = previous->second;
+      } else {
+        output.data[i] = fast_multiply(previous->second, product_range(previous->first + 1, n - previous->first));
+      }
+      memo.insert(n, output.data[i]);
+    }
+  }
+
+  return std::move(output).encode();
+}
+
+[[cpp11::register]]
+cpp11::strings c_biginteger_choose(cpp11::strings lhs, cpp11::integers rhs) {
+  return memoised_operation(
+    biginteger_vector(lhs), rhs,
+    [](const biginteger_type &n, int k) { return binomial(n, k); }
+  ).encode();
+}
+
+[[cpp11::register]]
+cpp11::strings c_biginteger_falling(cpp11::strings lhs, cpp11::integers rhs) {
+  return memoised_operation(
+    biginteger_vector(lhs), rhs,
+    [](const biginteger_type &x, int k) {
+      if (k < 0) {
+        throw std::domain_error("negative length");
+      }
+      return falling_factorial(x, k);
+    }
+  ).encode();
+}
+
+[[cpp11::register]]
+cpp11::strings c_biginteger_rising(cpp11::strings lhs, cpp11::integers rhs) {
+  return memoised_operation(
+    biginteger_vector(lhs), rhs,
+    [](const biginteger_type &x, int k) {
+      if (k < 0) {
+        throw std::domain_error("negative length");
+      }
+      return rising_factorial(x, k);
+    }
+  ).encode();
+}
+
+
+/*-----------------*
+ *  Number theory  *
+ *-----------------*/
+// Candidates are independent and expensive, so these run in parallel. A
+// factorisation can take seconds, so factors are shared out one at a time.
+static const std::size_t prime_block_size = 16;
+static const std::size_t factor_block_size = 1;
+
+[[cpp11::register]]
+cpp11::logicals c_biginteger_is_prime(cpp11::strings x) {
+  biginteger_vector input(x);
+  std::vector<int> result(input.size());
+
+  parallel_blocks(input.size(), prime_block_size, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i=begin; i<end; ++i) {
+      result[i] = input.is_na[i] ? NA_LOGICAL : is_prime(input.data[i]);
+    }
+  });
+
+  cpp11::writable::logicals output(input.size());
+  for (std::size_t i=0; i<input.size(); ++i) {
+    output[i] = result[i];
+  }
+  return output;
+}
+
+[[cpp11::register]]
+cpp11::strings c_biginteger_next_prime(cpp11::strings x) {
+  biginteger_vector input(x);
+  biginteger_vector output(input.size());
+  output.is_na = input.is_na;
+
+  parallel_blocks(input.size(), prime_block_size, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i=begin; i<end; ++i) {
+      if (!input.is_na[i]) {
+        output.data[i] = next_prime(input.data[i]);
+      }
+    }
+  });
+
+  return std::move(output).encode();
+}
+
+[[cpp11::register]]
+cpp11::list c_biginteger_prime_factors(cpp11::strings x) {
+  biginteger_vector input(x);
+  std::vector<std::vector<biginteger_type>> factors(input.size());
+  std::vector<char> found(input.size(), false);
+
+  parallel_blocks(input.size(), factor_block_size, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i=begin; i<end; ++i) {
+      if (!input.is_na[i] && input.data[i] != 0) {
+        found[i] = prime_factors(input.data[i], factors[i]);
+      }
+    }
+  });
+
+  cpp11::writable::list output(input.size());
+  for (std::size_t i=0; i<input.size(); ++i) {
+    if (!found[i]) {
+      output[i] = biginteger_vector(1, 0, true).encode();
+      continue;
+    }
+
+    biginteger_vector element(0);
+    if (input.data[i] < 0) {
+      element.data.push_back(-1);
+    }
+    element.data.insert(element.data.end(), factors[i].begin(), factors[i].end());
+    element.is_na.resize(element.data.size(), false);
+    output[i] = std::move(element).encode();
+  }
+
+  return output;
+}
+
+
 /*-----------------------*
  *  Sequence operations  *
  *-----------------------*/
@@ -257,13 +664,7 @@ cpp11::strings c_biginteger_seq_to_by(const cpp11::strings& from,
 
   const std::size_t size = static_cast<std::size_t>(length_out);
 
-  biginteger_vector output(size);
-
-  for (std::size_t i=0; i<size; ++i) {
-    output.data[i] = start + step * i;
-  }
-
-  return output.encode();
+  return encode_sequence(biginteger_sequence(start, step, size));
 }
 
 [[cpp11::register]]
@@ -274,12 +675,9 @@ cpp11::strings c_biginteger_seq_to_lo(const cpp11::strings& from,
   const biginteger_type end = biginteger_type(std::string(to[0]));
   const std::size_t size = length_out[0];
 
-  biginteger_vector output(size);
-
   if (size == 1) {
     // Avoid division by zero
-    output.data[0] = start;
-    return output.encode();
+    return encode_sequence(biginteger_sequence(start, 0, size));
   }
 
   const biginteger_type num = end - start;
@@ -295,11 +693,7 @@ cpp11::strings c_biginteger_seq_to_lo(const cpp11::strings& from,
     );
   }
 
-  for (std::size_t i=0; i<size; ++i) {
-    output.data[i] = start + step * i;
-  }
-
-  return output.encode();
+  return encode_sequence(biginteger_sequence(start, step, size));
 }
 
 [[cpp11::register]]
@@ -310,11 +704,5 @@ cpp11::strings c_biginteger_seq_by_lo(const cpp11::strings& from,
   const biginteger_type step = biginteger_type(std::string(by[0]));
   const std::size_t size = length_out[0];
 
-  biginteger_vector output(size);
-
-  for (std::size_t i=0; i<size; ++i) {
-    output.data[i] = start + step * i;
-  }
-
-  return output.encode();
+  return encode_sequence(biginteger_sequence(start, step, size));
 }
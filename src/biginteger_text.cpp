@@ -0,0 +1,37 @@
+#include "biginteger_text.h"
+#include "interrupt.h"
+
+
+biginteger_text::biginteger_text(cpp11::strings input)
+  : x(input), text(x.size(), NULL), length(x.size(), 0), is_na(x.size(), false), is_canonical(x.size(), true) {
+  for (interrupt_blocks block(size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (x[i] == NA_STRING) {
+        is_na[i] = true;
+        continue;
+      }
+
+      text[i] = CHAR(x[i]);
+      length[i] = x[i].size();
+      if (is_canonical_decimal(text[i], text[i] + length[i])) {
+        continue;
+      }
+
+      is_canonical[i] = false;
+      if (parsed.empty()) {
+        parsed.resize(size());
+      }
+      is_na[i] = !parse_biginteger(text[i], text[i] + length[i], parsed[i]);
+    }
+  }
+}
+
+biginteger_type biginteger_text::value(std::size_t i) const {
+  if (!is_canonical[i]) {
+    return parsed[i];
+  }
+
+  biginteger_type output;
+  parse_biginteger(text[i], text[i] + length[i], output);
+  return output;
+}
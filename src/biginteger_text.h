@@ -0,0 +1,106 @@
+#ifndef __BIGINTEGER_TEXT__
+#define __BIGINTEGER_TEXT__
+
+#include <cstring>
+#include <vector>
+#include <cpp11.hpp>
+#include "biginteger_vector.h"
+
+/*
+ * Biginteger values compared as text, without parsing.
+ *
+ * Biginteger vectors store canonical decimal strings: an optional minus
+ * sign, then digits without leading zeros ("0" for zero, never "-0"). For
+ * these, the sign, the number of digits and then the digits themselves
+ * (lexicographically) order the values, and equal values have equal text.
+ * Identical strings also share one CHARSXP in R's string cache, so
+ * comparing pointers often settles equality.
+ *
+ * Other strings (e.g. hexadecimal, or leading zeros in a bare character
+ * vector) are parsed when the vector is built.
+ */
+
+// Does [first, last) hold a canonical decimal string?
+inline bool is_canonical_decimal(const char *first, const char *last) {
+  if (first != last && *first == '-') {
+    ++first;
+    // "-0" isn't canonical
+    if (last - first == 1 && *first == '0') {
+      return false;
+    }
+  }
+  if (first == last || (*first == '0' && last - first > 1)) {
+    return false;
+  }
+  for (; first != last; ++first) {
+    if (*first < '0' || *first > '9') {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Three-way comparison of canonical decimal strings
+inline int compare_canonical_decimal(const char *x, std::size_t x_size, const char *y, std::size_t y_size) {
+  const bool x_negative = x[0] == '-', y_negative = y[0] == '-';
+  if (x_negative != y_negative) {
+    return x_negative ? -1 : 1;
+  }
+
+  int magnitude;
+  if (x_size != y_size) {
+    magnitude = x_size < y_size ? -1 : 1;
+  } else {
+    const int cmp = std::memcmp(x, y, x_size);
+    magnitude = cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+  }
+
+  return x_negative ? -magnitude : magnitude;
+}
+
+class biginteger_text {
+public:
+  cpp11::strings x;
+  // Characters of each element (the same pointer for the same CHARSXP)
+  std::vector<const char*> text;
+  std::vector<std::size_t> length;
+  std::vector<bool> is_na;
+  std::vector<bool> is_canonical;
+  // Parsed values of the non-canonical elements (empty if there are none)
+  std::vector<biginteger_type> parsed;
+  std::size_t size() const { return is_na.size(); }
+
+
+  // Keeps `input`, which owns the text
+  explicit biginteger_text(cpp11::strings input);
+
+  // Value of element `i` (not NA), parsing canonical text on demand
+  biginteger_type value(std::size_t i) const;
+};
+
+inline int compare_elements(const biginteger_text &lhs, const biginteger_text &rhs, std::size_t i) {
+  if (lhs.text[i] == rhs.text[i]) {
+    return 0;
+  }
+
+  if (lhs.is_canonical[i] && rhs.is_canonical[i]) {
+    return compare_canonical_decimal(lhs.text[i], lhs.length[i], rhs.text[i], rhs.length[i]);
+  }
+
+  const biginteger_type x_value = lhs.value(i), y_value = rhs.value(i);
+  return x_value < y_value ? -1 : (x_value > y_value ? 1 : 0);
+}
+
+inline bool equal_elements(const biginteger_text &lhs, const biginteger_text &rhs, std::size_t i) {
+  if (lhs.text[i] == rhs.text[i]) {
+    return true;
+  }
+
+  if (lhs.is_canonical[i] && rhs.is_canonical[i]) {
+    return lhs.length[i] == rhs.length[i] && std::memcmp(lhs.text[i], rhs.text[i], lhs.length[i]) == 0;
+  }
+
+  return lhs.value(i) == rhs.value(i);
+}
+
+#endif
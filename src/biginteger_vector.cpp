@@ -1,39 +1,81 @@
 #include "biginteger_vector.h"
 #include "format.h"
+#include "cache.h"
+#include "interrupt.h"
+#include "altrep.h"
 
 
 biginteger_vector::biginteger_vector(cpp11::strings x) : biginteger_vector(x.size()) {
+  // values of a lazy result don't need parsing
+  const biginteger_vector *lazy = lazy_biginteger_values(x);
+  if (lazy != NULL) {
+    *this = *lazy;
+    return;
+  }
+
   std::size_t vsize = x.size();
-  for (std::size_t i=0; i<vsize; ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
+  parse_cache cache(vsize);
+  for (interrupt_blocks block(vsize); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      std::size_t first;
+      if (x[i] == NA_STRING) {
+        is_na[i] = true;
+      } else if (cache.find(x[i], i, first)) {
+        data[i] = data[first];
+        is_na[i] = is_na[first];
+      } else {
+        const char *str = CHAR(x[i]);
+        is_na[i] = !parse_biginteger(str, str + x[i].size(), data[i]);
+      }
     }
+  }
+}
 
-    if (x[i] == NA_STRING || x[i].size() == 0) {
-      is_na[i] = true;
-    } else {
-      try {
-        std::string str(x[i]);
-
-        // remove leading zeros (unless hexadecimal)
-        if (str[0] == '0') {
-          if (str.size() >= 2 && str.compare(0, 2, "0x") != 0 && str.compare(0, 2, "0X") != 0) {
-            str.erase(0, str.find_first_not_of('0'));
-          }
-        }
-
-        data[i] = biginteger_type(str);
-      } catch (...) {
-        is_na[i] = true;
+bool parse_biginteger(const char *first, const char *last, biginteger_type &value) {
+  if (first == last) {
+    return false;
+  }
+
+  try {
+    std::string str(first, last);
+
+    // remove leading zeros (unless hexadecimal)
+    if (str[0] == '0') {
+      if (str.size() >= 2 && str.compare(0, 2, "0x") != 0 && str.compare(0, 2, "0X") != 0) {
+        str.erase(0, str.find_first_not_of('0'));
       }
     }
+
+    value = biginteger_type(str);
+  } catch (...) {
+    return false;
   }
+
+  return true;
 }
 
 
-cpp11::strings biginteger_vector::encode() const {
+cpp11::strings biginteger_vector::encode() const & {
+#ifdef BIGNUM_ALTREP
+  if (use_lazy_encoding(size())) {
+    return biginteger_vector(*this).encode();
+  }
+#endif
+
   cpp11::writable::strings output = format_biginteger_vector(*this, bignum_format_dec);
 
   output.attr("class") = {"bignum_biginteger", "bignum_vctr", "vctrs_vctr"};
   return output;
 }
+
+cpp11::strings biginteger_vector::encode() && {
+#ifdef BIGNUM_ALTREP
+  if (use_lazy_encoding(size())) {
+    cpp11::sexp output(new_lazy_strings(std::move(*this)));
+    output.attr("class") = {"bignum_biginteger", "bignum_vctr", "vctrs_vctr"};
+    return cpp11::strings(output);
+  }
+#endif
+
+  return static_cast<const biginteger_vector&>(*this).encode();
+}
@@ -4,9 +4,18 @@
 #include <vector>
 #include <cpp11.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
+#include "limb_pool.h"
 
 
-typedef boost::multiprecision::checked_cpp_int biginteger_type;
+// Like checked_cpp_int, with limbs allocated from per-thread pools
+typedef boost::multiprecision::number<
+  boost::multiprecision::cpp_int_backend<
+    0, 0,
+    boost::multiprecision::signed_magnitude,
+    boost::multiprecision::checked,
+    pool_allocator<boost::multiprecision::limb_type>
+  >
+> biginteger_type;
 
 class biginteger_vector {
 public:
@@ -20,7 +29,12 @@ public:
 
   biginteger_vector(cpp11::strings x);
 
-  cpp11::strings encode() const;
+  // Formatted as a classed character vector. Large results are returned
+  // lazily (see altrep.h), taking over the values of a temporary.
+  cpp11::strings encode() const &;
+  cpp11::strings encode() &&;
 };
 
+bool parse_biginteger(const char *first, const char *last, biginteger_type &value);
+
 #endif
@@ -0,0 +1,85 @@
+#ifndef __BIGNUM_BITWISE__
+#define __BIGNUM_BITWISE__
+
+#include <bitset>
+#include <climits>
+#include <stdexcept>
+#include <boost/multiprecision/cpp_int.hpp>
+#include "biginteger_vector.h"
+
+/*
+ * Bitwise operations on biginteger values.
+ *
+ * Negative values behave as if stored in two's complement with infinitely
+ * many leading one bits. Non-negative operands are handled directly on the
+ * limbs. The checked type rejects bitwise operations on negative values, so
+ * those are computed with the unchecked type, which emulates two's
+ * complement.
+ */
+
+template<class Op>
+biginteger_type bitwise_operation(const biginteger_type &x, const biginteger_type &y, const Op &op) {
+  if (x >= 0 && y >= 0) {
+    return op(x, y);
+  }
+
+  typedef boost::multiprecision::cpp_int unchecked_type;
+  return biginteger_type(op(unchecked_type(x), unchecked_type(y)));
+}
+
+struct bitwise_and {
+  template<class T> T operator()(const T &x, const T &y) const { return x & y; }
+};
+
+struct bitwise_or {
+  template<class T> T operator()(const T &x, const T &y) const { return x | y; }
+};
+
+struct bitwise_xor {
+  template<class T> T operator()(const T &x, const T &y) const { return x ^ y; }
+};
+
+inline biginteger_type bitwise_not(const biginteger_type &x) {
+  return -x - 1;
+}
+
+inline biginteger_type shift_left(const biginteger_type &x, int n) {
+  if (n < 0) {
+    throw std::domain_error("negative shift");
+  }
+  return x < 0 ? biginteger_type(-(biginteger_type(-x) << n)) : biginteger_type(x << n);
+}
+
+// Rounds towards negative infinity, like division by 2^n
+inline biginteger_type shift_right(const biginteger_type &x, int n) {
+  if (n < 0) {
+    throw std::domain_error("negative shift");
+  }
+  return x < 0 ? biginteger_type(-(biginteger_type(-x - 1) >> n) - 1) : biginteger_type(x >> n);
+}
+
+// Number of one bits (negative values have infinitely many)
+inline bool popcount(const biginteger_type &x, int &count) {
+  if (x < 0) {
+    return false;
+  }
+
+  typedef boost::multiprecision::limb_type limb_type;
+  const limb_type *limbs = x.backend().limbs();
+
+  count = 0;
+  for (std::size_t k=0; k<x.backend().size(); ++k) {
+    count += std::bitset<sizeof(limb_type) * CHAR_BIT>(limbs[k]).count();
+  }
+  return true;
+}
+
+// Bit `n` (0 is the least significant bit)
+inline bool test_bit(const biginteger_type &x, unsigned n) {
+  if (x < 0) {
+    return !boost::multiprecision::bit_test(biginteger_type(-x - 1), n);
+  }
+  return boost::multiprecision::bit_test(x, n);
+}
+
+#endif
@@ -0,0 +1,30 @@
+#include <cpp11.hpp>
+#include "cache.h"
+
+using namespace cpp11::literals;
+
+
+[[cpp11::register]]
+cpp11::list c_bignum_cache_stats(bool reset) {
+  cache_counter &parse = parse_cache_counter();
+  cache_counter &encode = encode_cache_counter();
+
+  cpp11::writable::list output({
+    "cache"_nm = cpp11::writable::strings({"parse", "encode"}),
+    "lookups"_nm = cpp11::writable::doubles({
+      static_cast<double>(parse.lookups),
+      static_cast<double>(encode.lookups)
+    }),
+    "hits"_nm = cpp11::writable::doubles({
+      static_cast<double>(parse.hits),
+      static_cast<double>(encode.hits)
+    })
+  });
+
+  if (reset) {
+    parse = cache_counter();
+    encode = cache_counter();
+  }
+
+  return output;
+}
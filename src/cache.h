@@ -0,0 +1,94 @@
+#ifndef __BIGNUM_CACHE__
+#define __BIGNUM_CACHE__
+
+#include <cstdint>
+#include <unordered_map>
+#include <cpp11.hpp>
+#include "options.h"
+
+/*
+ * Per-call caches for repeated values.
+ *
+ * R's global string cache means identical strings share one CHARSXP, so a
+ * column with many repeated values can be parsed once per distinct CHARSXP.
+ * Likewise, repeated values only need to be formatted once when encoding.
+ *
+ * Hashing is not free, so each cache watches its own hit rate and disables
+ * itself for the rest of the call if too few lookups are hits. Session-wide
+ * counters are kept for `bignum_cache_stats()`.
+ */
+
+struct cache_counter {
+  uint64_t lookups = 0;
+  uint64_t hits = 0;
+};
+
+inline cache_counter& parse_cache_counter() {
+  static cache_counter counter;
+  return counter;
+}
+
+inline cache_counter& encode_cache_counter() {
+  static cache_counter counter;
+  return counter;
+}
+
+class cache_policy {
+public:
+  cache_policy(cache_counter &counter, std::size_t size)
+    : counter(counter), enabled(size > 1 && option_flag("bignum.string_cache", true)) {}
+
+  ~cache_policy() {
+    counter.lookups += lookups;
+    counter.hits += hits;
+  }
+
+  bool active() const { return enabled; }
+
+  // Returns false once the probe window shows caching isn't worthwhile.
+  bool record(bool hit) {
+    ++lookups;
+    hits += hit;
+    if (lookups == probe_size && hits * min_hit_ratio < lookups) {
+      enabled = false;
+    }
+    return enabled;
+  }
+
+private:
+  static const uint64_t probe_size = 1024;
+  static const uint64_t min_hit_ratio = 16;
+
+  cache_counter &counter;
+  bool enabled;
+  uint64_t lookups = 0;
+  uint64_t hits = 0;
+};
+
+// Maps each CHARSXP to the index where it was first parsed.
+class parse_cache {
+public:
+  explicit parse_cache(std::size_t size) : policy(parse_cache_counter(), size) {}
+
+  // Returns true (and sets `first`) if `key` was already seen at `first`.
+  bool find(SEXP key, std::size_t i, std::size_t &first) {
+    if (!policy.active()) {
+      return false;
+    }
+
+    std::pair<std::unordered_map<SEXP, std::size_t>::iterator, bool> found =
+      seen.insert(std::make_pair(key, i));
+    first = found.first->second;
+
+    if (!policy.record(!found.second)) {
+      std::unordered_map<SEXP, std::size_t>().swap(seen);
+    }
+    return !found.second;
+  }
+
+private:
+  cache_policy policy;
+  std::unordered_map<SEXP, std::size_t> seen;
+};
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef __BIGNUM_CAST__
+#define __BIGNUM_CAST__
+
+#include <cpp11.hpp>
+#include "bigfloat_vector.h"
+
+/*
+ * Cast kernels return the converted vector together with a logical vector
+ * flagging elements that lost information, so both come from one pass over
+ * the parsed input.
+ */
+inline cpp11::list cast_result(SEXP value, SEXP lossy) {
+  cpp11::writable::list output({value, lossy});
+  output.names() = {"value", "lossy"};
+  return output;
+}
+
+// Truncates towards zero (lossy if there was a fractional part or the value
+// isn't finite)
+cpp11::list bigfloat_to_biginteger(const bigfloat_vector &x);
+
+#endif
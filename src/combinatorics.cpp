@@ -0,0 +1,33 @@
+#include "combinatorics.h"
+#include "multiply.h"
+
+
+biginteger_type product_range(const biginteger_type &x, unsigned count) {
+  // Below this, operands are small enough for schoolbook multiplication
+  if (count <= 16) {
+    biginteger_type output = 1;
+    for (unsigned i=0; i<count; ++i) {
+      output *= x + i;
+    }
+    return output;
+  }
+
+  const unsigned half = count / 2;
+  return fast_multiply(product_range(x, half), product_range(x + half, count - half));
+}
+
+biginteger_type binomial(const biginteger_type &n, int k) {
+  if (k < 0) {
+    return 0;
+  }
+  if (n >= 0) {
+    if (n < k) {
+      return 0;
+    }
+    // choose(n, k) == choose(n, n - k), and the smaller k is cheaper
+    if (n - k < k) {
+      k = static_cast<int>(n - k);
+    }
+  }
+  return fast_quotient(falling_factorial(n, k), factorial(k));
+}
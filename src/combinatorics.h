@@ -0,0 +1,112 @@
+#ifndef __BIGNUM_COMBINATORICS__
+#define __BIGNUM_COMBINATORICS__
+
+#include <deque>
+#include <map>
+#include <utility>
+#include "biginteger_vector.h"
+#include "interrupt.h"
+
+/*
+ * Factorials and binomial coefficients.
+ *
+ * Products of consecutive integers are computed by binary splitting: the
+ * range is halved recursively, so the large multiplications combine
+ * operands of similar size (which is much faster than folding from the left).
+ */
+
+// x * (x + 1) * ... * (x + count - 1)
+biginteger_type product_range(const biginteger_type &x, unsigned count);
+
+// x * (x - 1) * ... * (x - k + 1)
+inline biginteger_type falling_factorial(const biginteger_type &x, unsigned k) {
+  return k == 0 ? biginteger_type(1) : product_range(x - (k - 1), k);
+}
+
+// x * (x + 1) * ... * (x + k - 1)
+inline biginteger_type rising_factorial(const biginteger_type &x, unsigned k) {
+  return product_range(x, k);
+}
+
+inline biginteger_type factorial(unsigned n) {
+  return n == 0 ? biginteger_type(1) : product_range(1, n);
+}
+
+// Binomial coefficient, extended to negative n (0 for k < 0)
+biginteger_type binomial(const biginteger_type &n, int k);
+
+/*
+ * The most recent results of an element loop, so repeated arguments are
+ * computed once. The oldest entry is evicted when full.
+ */
+template<class Key>
+class recent_results {
+public:
+  explicit recent_results(std::size_t capacity = 64) : capacity(capacity) {}
+
+  const biginteger_type* find(const Key &key) const {
+    typename std::map<Key, biginteger_type>::const_iterator it = values.find(key);
+    return it == values.end() ? NULL : &it->second;
+  }
+
+  // Entry with the largest key not greater than `key`
+  const std::pair<const Key, biginteger_type>* find_at_most(const Key &key) const {
+    typename std::map<Key, biginteger_type>::const_iterator it = values.upper_bound(key);
+    return it == values.begin() ? NULL : &*(--it);
+  }
+
+  void insert(const Key &key, const biginteger_type &value) {
+    if (values.find(key) != values.end()) {
+      return;
+    }
+    if (order.size() == capacity) {
+      values.erase(order.front());
+      order.pop_front();
+    }
+    values.insert(std::make_pair(key, value));
+    order.push_back(key);
+  }
+
+private:
+  std::size_t capacity;
+  std::map<Key, biginteger_type> values;
+  std::deque<Key> order;
+};
+
+// binary_operation(), reusing results for repeated pairs of arguments
+template<class Func>
+biginteger_vector memoised_operation(const biginteger_vector &lhs, const cpp11::integers &rhs, const Func &BinaryOperation) {
+  if (lhs.size() != static_cast<std::size_t>(rhs.size())) {
+    cpp11::stop("Incompatible sizes"); // # nocov
+  }
+
+  biginteger_vector output(lhs.size());
+  recent_results<std::pair<biginteger_type, int> > memo;
+
+  for (interrupt_blocks block(lhs.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (lhs.is_na[i] || rhs[i] == NA_INTEGER) {
+        output.is_na[i] = true;
+        continue;
+      }
+
+      const std::pair<biginteger_type, int> key(lhs.data[i], rhs[i]);
+      const biginteger_type *cached = memo.find(key);
+      if (cached != NULL) {
+        output.data[i] = *cached;
+        continue;
+      }
+
+      try {
+        output.data[i] = BinaryOperation(lhs.data[i], rhs[i]);
+        memo.insert(key, output.data[i]);
+      } catch (...) {
+        output.is_na[i] = true;
+      }
+    }
+  }
+
+  return output;
+}
+
+#endif
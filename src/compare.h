@@ -1,8 +1,30 @@
 #include <vector>
 #include <algorithm>
 #include <cpp11.hpp>
+#include "interrupt.h"
+#include "operations.h"
 
 
+// Three-way comparison of non-missing elements. Storage layouts that can
+// compare without loading values (e.g. biginteger_arena) overload this.
+template<class Vec>
+int compare_elements(const Vec &lhs, const Vec &rhs, std::size_t i) {
+  if (lhs.data[i] < rhs.data[i]) {
+    return -1;
+  } else if (lhs.data[i] > rhs.data[i]) {
+    return 1;
+  } else {
+    return 0;
+  }
+}
+
+// Equality of non-missing elements. Storage layouts with a cheaper test
+// than ordering (e.g. biginteger_text) overload this.
+template<class Vec>
+bool equal_elements(const Vec &lhs, const Vec &rhs, std::size_t i) {
+  return compare_elements(lhs, rhs, i) == 0;
+}
+
 template<class Vec>
 cpp11::integers bignum_cmp(const Vec &lhs, const Vec &rhs, bool na_equal) {
   if (lhs.size() != rhs.size()) {
@@ -11,25 +33,44 @@ cpp11::integers bignum_cmp(const Vec &lhs, const Vec &rhs, bool na_equal) {
 
   cpp11::writable::integers output(lhs.size());
 
-  for (std::size_t i=0; i<lhs.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
+  for (interrupt_blocks block(lhs.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (!na_equal && (lhs.is_na[i] || rhs.is_na[i])) {
+        output[i] = NA_INTEGER;
+      } else if (lhs.is_na[i] && rhs.is_na[i]) {
+        output[i] = 0;
+      } else if (lhs.is_na[i]) {
+        output[i] = -1;
+      } else if (rhs.is_na[i]) {
+        output[i] = 1;
+      } else {
+        output[i] = compare_elements(lhs, rhs, i);
+      }
     }
+  }
+
+  return output;
+}
 
-    if (!na_equal && (lhs.is_na[i] || rhs.is_na[i])) {
-      output[i] = NA_INTEGER;
-    } else if (lhs.is_na[i] && rhs.is_na[i]) {
-      output[i] = 0;
-    } else if (lhs.is_na[i]) {
-      output[i] = -1;
-    } else if (rhs.is_na[i]) {
-      output[i] = 1;
-    } else if (lhs.data[i] < rhs.data[i]) {
-      output[i] = -1;
-    } else if (lhs.data[i] > rhs.data[i]) {
-      output[i] = 1;
-    } else {
-      output[i] = 0;
+template<class Vec>
+cpp11::logicals bignum_equal(const Vec &lhs, const Vec &rhs, bool na_equal) {
+  if (lhs.size() != rhs.size()) {
+    cpp11::stop("Incompatible sizes"); // # nocov
+  }
+
+  cpp11::writable::logicals output(lhs.size());
+
+  for (interrupt_blocks block(lhs.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (lhs.is_na[i] || rhs.is_na[i]) {
+        if (na_equal) {
+          output[i] = lhs.is_na[i] && rhs.is_na[i] ? TRUE : FALSE;
+        } else {
+          output[i] = NA_LOGICAL;
+        }
+      } else {
+        output[i] = equal_elements(lhs, rhs, i) ? TRUE : FALSE;
+      }
     }
   }
 
@@ -41,27 +82,23 @@ std::vector<int> std_dense_rank(const std::vector<T> &input) {
   std::vector<int> result(input.size());
   std::vector<std::pair<T, size_t> > sorted(input.size());
 
-  for (size_t i=0; i<input.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      sorted[i] = std::make_pair(input[i], i);
     }
-
-    sorted[i] = std::make_pair(input[i], i);
   }
 
   std::sort(sorted.begin(), sorted.end());
 
   std::pair<T, size_t> rank(sorted[0].first, 1);
-  for (size_t i=0; i<input.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (sorted[i].first != rank.first) {
+        rank.first = sorted[i].first;
+        rank.second++;
+      }
+      result[sorted[i].second] = rank.second;
     }
-
-    if (sorted[i].first != rank.first) {
-      rank.first = sorted[i].first;
-      rank.second++;
-    }
-    result[sorted[i].second] = rank.second;
   }
 
   return result;
@@ -72,27 +109,25 @@ cpp11::integers dense_rank(const Vec &input) {
   cpp11::writable::integers output(input.size());
 
   std::vector<bignum_type> without_na;
-  for (size_t i=0; i<input.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
-
-    if (!input.is_na[i]) {
-      without_na.push_back(input.data[i]);
+  element_reader<Vec> read(input);
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (!input.is_na[i]) {
+        without_na.push_back(read(i));
+      }
     }
   }
 
   std::vector<int> ranks = std_dense_rank(without_na);
 
-  for (size_t i=0, i_rank=0; i<input.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
-
-    if (input.is_na[i]) {
-      output[i] = NA_INTEGER;
-    } else {
-      output[i] = ranks[i_rank++];
+  std::size_t i_rank = 0;
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (input.is_na[i]) {
+        output[i] = NA_INTEGER;
+      } else {
+        output[i] = ranks[i_rank++];
+      }
     }
   }
 
@@ -5,6 +5,35 @@
 #include "cpp11/declarations.hpp"
 #include <R_ext/Visibility.h>
 
+// accumulator.cpp
+SEXP c_accumulator_new(std::string statistic, std::string type, bool na_rm);
+extern "C" SEXP _bignum_c_accumulator_new(SEXP statistic, SEXP type, SEXP na_rm) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_accumulator_new(cpp11::as_cpp<cpp11::decay_t<std::string>>(statistic), cpp11::as_cpp<cpp11::decay_t<std::string>>(type), cpp11::as_cpp<cpp11::decay_t<bool>>(na_rm)));
+  END_CPP11
+}
+// accumulator.cpp
+void c_accumulator_update(SEXP ptr, cpp11::strings chunk);
+extern "C" SEXP _bignum_c_accumulator_update(SEXP ptr, SEXP chunk) {
+  BEGIN_CPP11
+    c_accumulator_update(cpp11::as_cpp<cpp11::decay_t<SEXP>>(ptr), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(chunk));
+    return R_NilValue;
+  END_CPP11
+}
+// accumulator.cpp
+SEXP c_accumulator_merge(SEXP lhs, SEXP rhs);
+extern "C" SEXP _bignum_c_accumulator_merge(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_accumulator_merge(cpp11::as_cpp<cpp11::decay_t<SEXP>>(lhs), cpp11::as_cpp<cpp11::decay_t<SEXP>>(rhs)));
+  END_CPP11
+}
+// accumulator.cpp
+SEXP c_accumulator_result(SEXP ptr);
+extern "C" SEXP _bignum_c_accumulator_result(SEXP ptr) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_accumulator_result(cpp11::as_cpp<cpp11::decay_t<SEXP>>(ptr)));
+  END_CPP11
+}
 // bigfloat_interface.cpp
 cpp11::strings c_bigfloat(cpp11::strings x);
 extern "C" SEXP _bignum_c_bigfloat(SEXP x) {
@@ -13,27 +42,34 @@ extern "C" SEXP _bignum_c_bigfloat(SEXP x) {
   END_CPP11
 }
 // bigfloat_interface.cpp
-cpp11::logicals c_bigfloat_to_logical(cpp11::strings x);
+cpp11::list c_bigfloat_to_logical(cpp11::strings x);
 extern "C" SEXP _bignum_c_bigfloat_to_logical(SEXP x) {
   BEGIN_CPP11
     return cpp11::as_sexp(c_bigfloat_to_logical(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
   END_CPP11
 }
 // bigfloat_interface.cpp
-cpp11::integers c_bigfloat_to_integer(cpp11::strings x);
+cpp11::list c_bigfloat_to_integer(cpp11::strings x);
 extern "C" SEXP _bignum_c_bigfloat_to_integer(SEXP x) {
   BEGIN_CPP11
     return cpp11::as_sexp(c_bigfloat_to_integer(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
   END_CPP11
 }
 // bigfloat_interface.cpp
-cpp11::doubles c_bigfloat_to_double(cpp11::strings x);
+cpp11::list c_bigfloat_to_double(cpp11::strings x);
 extern "C" SEXP _bignum_c_bigfloat_to_double(SEXP x) {
   BEGIN_CPP11
     return cpp11::as_sexp(c_bigfloat_to_double(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
   END_CPP11
 }
 // bigfloat_interface.cpp
+cpp11::list c_bigfloat_to_biginteger(cpp11::strings x);
+extern "C" SEXP _bignum_c_bigfloat_to_biginteger(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_to_biginteger(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
 cpp11::strings c_bigfloat_format(cpp11::strings x, cpp11::strings notation, cpp11::integers digits, bool is_sigfig);
 extern "C" SEXP _bignum_c_bigfloat_format(SEXP x, SEXP notation, SEXP digits, SEXP is_sigfig) {
   BEGIN_CPP11
@@ -41,6 +77,13 @@ extern "C" SEXP _bignum_c_bigfloat_format(SEXP x, SEXP notation, SEXP digits, SE
   END_CPP11
 }
 // bigfloat_interface.cpp
+cpp11::logicals c_bigfloat_is_na(cpp11::strings x);
+extern "C" SEXP _bignum_c_bigfloat_is_na(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_is_na(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
 cpp11::integers c_bigfloat_compare(cpp11::strings lhs, cpp11::strings rhs, bool na_equal);
 extern "C" SEXP _bignum_c_bigfloat_compare(SEXP lhs, SEXP rhs, SEXP na_equal) {
   BEGIN_CPP11
@@ -48,6 +91,13 @@ extern "C" SEXP _bignum_c_bigfloat_compare(SEXP lhs, SEXP rhs, SEXP na_equal) {
   END_CPP11
 }
 // bigfloat_interface.cpp
+SEXP c_bigfloat_compare_mixed(SEXP lhs, SEXP rhs, bool na_equal, bool allow_lossy);
+extern "C" SEXP _bignum_c_bigfloat_compare_mixed(SEXP lhs, SEXP rhs, SEXP na_equal, SEXP allow_lossy) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_compare_mixed(cpp11::as_cpp<cpp11::decay_t<SEXP>>(lhs), cpp11::as_cpp<cpp11::decay_t<SEXP>>(rhs), cpp11::as_cpp<cpp11::decay_t<bool>>(na_equal), cpp11::as_cpp<cpp11::decay_t<bool>>(allow_lossy)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
 cpp11::integers c_bigfloat_rank(cpp11::strings x);
 extern "C" SEXP _bignum_c_bigfloat_rank(SEXP x) {
   BEGIN_CPP11
@@ -97,6 +147,13 @@ extern "C" SEXP _bignum_c_bigfloat_modulo(SEXP lhs, SEXP rhs) {
   END_CPP11
 }
 // bigfloat_interface.cpp
+SEXP c_bigfloat_arith_mixed(std::string op, SEXP lhs, SEXP rhs);
+extern "C" SEXP _bignum_c_bigfloat_arith_mixed(SEXP op, SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_arith_mixed(cpp11::as_cpp<cpp11::decay_t<std::string>>(op), cpp11::as_cpp<cpp11::decay_t<SEXP>>(lhs), cpp11::as_cpp<cpp11::decay_t<SEXP>>(rhs)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
 cpp11::strings c_bigfloat_sum(cpp11::strings x, bool na_rm);
 extern "C" SEXP _bignum_c_bigfloat_sum(SEXP x, SEXP na_rm) {
   BEGIN_CPP11
@@ -202,6 +259,13 @@ extern "C" SEXP _bignum_c_bigfloat_log(SEXP lhs) {
   END_CPP11
 }
 // bigfloat_interface.cpp
+cpp11::strings c_bigfloat_log_base(cpp11::strings lhs, cpp11::strings rhs);
+extern "C" SEXP _bignum_c_bigfloat_log_base(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_log_base(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(rhs)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
 cpp11::strings c_bigfloat_log10(cpp11::strings lhs);
 extern "C" SEXP _bignum_c_bigfloat_log10(SEXP lhs) {
   BEGIN_CPP11
@@ -237,6 +301,13 @@ extern "C" SEXP _bignum_c_bigfloat_cosh(SEXP lhs) {
   END_CPP11
 }
 // bigfloat_interface.cpp
+cpp11::strings c_bigfloat_cospi(cpp11::strings lhs);
+extern "C" SEXP _bignum_c_bigfloat_cospi(SEXP lhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_cospi(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
 cpp11::strings c_bigfloat_sin(cpp11::strings lhs);
 extern "C" SEXP _bignum_c_bigfloat_sin(SEXP lhs) {
   BEGIN_CPP11
@@ -251,6 +322,13 @@ extern "C" SEXP _bignum_c_bigfloat_sinh(SEXP lhs) {
   END_CPP11
 }
 // bigfloat_interface.cpp
+cpp11::strings c_bigfloat_sinpi(cpp11::strings lhs);
+extern "C" SEXP _bignum_c_bigfloat_sinpi(SEXP lhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_sinpi(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
 cpp11::strings c_bigfloat_tan(cpp11::strings lhs);
 extern "C" SEXP _bignum_c_bigfloat_tan(SEXP lhs) {
   BEGIN_CPP11
@@ -265,6 +343,13 @@ extern "C" SEXP _bignum_c_bigfloat_tanh(SEXP lhs) {
   END_CPP11
 }
 // bigfloat_interface.cpp
+cpp11::strings c_bigfloat_tanpi(cpp11::strings lhs);
+extern "C" SEXP _bignum_c_bigfloat_tanpi(SEXP lhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_tanpi(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
 cpp11::strings c_bigfloat_acos(cpp11::strings lhs);
 extern "C" SEXP _bignum_c_bigfloat_acos(SEXP lhs) {
   BEGIN_CPP11
@@ -300,6 +385,13 @@ extern "C" SEXP _bignum_c_bigfloat_atan(SEXP lhs) {
   END_CPP11
 }
 // bigfloat_interface.cpp
+cpp11::strings c_bigfloat_atan2(cpp11::strings lhs, cpp11::strings rhs);
+extern "C" SEXP _bignum_c_bigfloat_atan2(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_atan2(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(rhs)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
 cpp11::strings c_bigfloat_atanh(cpp11::strings lhs);
 extern "C" SEXP _bignum_c_bigfloat_atanh(SEXP lhs) {
   BEGIN_CPP11
@@ -335,6 +427,48 @@ extern "C" SEXP _bignum_c_bigfloat_trigamma(SEXP lhs) {
   END_CPP11
 }
 // bigfloat_interface.cpp
+cpp11::strings c_bigfloat_hypot(cpp11::strings lhs, cpp11::strings rhs);
+extern "C" SEXP _bignum_c_bigfloat_hypot(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_hypot(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(rhs)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
+cpp11::strings c_bigfloat_fma(cpp11::strings x, cpp11::strings y, cpp11::strings z);
+extern "C" SEXP _bignum_c_bigfloat_fma(SEXP x, SEXP y, SEXP z) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_fma(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(y), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(z)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
+SEXP c_bigfloat_range(cpp11::strings x, bool na_rm);
+extern "C" SEXP _bignum_c_bigfloat_range(SEXP x, SEXP na_rm) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_range(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x), cpp11::as_cpp<cpp11::decay_t<bool>>(na_rm)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
+cpp11::strings c_bigfloat_mean(cpp11::strings x, bool na_rm);
+extern "C" SEXP _bignum_c_bigfloat_mean(SEXP x, SEXP na_rm) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_mean(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x), cpp11::as_cpp<cpp11::decay_t<bool>>(na_rm)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
+cpp11::strings c_bigfloat_var(cpp11::strings x, bool na_rm);
+extern "C" SEXP _bignum_c_bigfloat_var(SEXP x, SEXP na_rm) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_var(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x), cpp11::as_cpp<cpp11::decay_t<bool>>(na_rm)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
+cpp11::list c_bigfloat_summary(cpp11::strings x, bool na_rm);
+extern "C" SEXP _bignum_c_bigfloat_summary(SEXP x, SEXP na_rm) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_summary(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x), cpp11::as_cpp<cpp11::decay_t<bool>>(na_rm)));
+  END_CPP11
+}
+// bigfloat_interface.cpp
 cpp11::strings c_bigfloat_seq_to_by(const cpp11::strings& from, const cpp11::strings& to, const cpp11::strings& by);
 extern "C" SEXP _bignum_c_bigfloat_seq_to_by(SEXP from, SEXP to, SEXP by) {
   BEGIN_CPP11
@@ -363,27 +497,41 @@ extern "C" SEXP _bignum_c_biginteger(SEXP x) {
   END_CPP11
 }
 // biginteger_interface.cpp
-cpp11::logicals c_biginteger_to_logical(cpp11::strings x);
+cpp11::list c_biginteger_to_logical(cpp11::strings x);
 extern "C" SEXP _bignum_c_biginteger_to_logical(SEXP x) {
   BEGIN_CPP11
     return cpp11::as_sexp(c_biginteger_to_logical(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
   END_CPP11
 }
 // biginteger_interface.cpp
-cpp11::integers c_biginteger_to_integer(cpp11::strings x);
+cpp11::list c_biginteger_to_integer(cpp11::strings x);
 extern "C" SEXP _bignum_c_biginteger_to_integer(SEXP x) {
   BEGIN_CPP11
     return cpp11::as_sexp(c_biginteger_to_integer(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
   END_CPP11
 }
 // biginteger_interface.cpp
-cpp11::doubles c_biginteger_to_double(cpp11::strings x);
+cpp11::list c_biginteger_to_double(cpp11::strings x);
 extern "C" SEXP _bignum_c_biginteger_to_double(SEXP x) {
   BEGIN_CPP11
     return cpp11::as_sexp(c_biginteger_to_double(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
   END_CPP11
 }
 // biginteger_interface.cpp
+cpp11::list c_biginteger_to_bigfloat(cpp11::strings x);
+extern "C" SEXP _bignum_c_biginteger_to_bigfloat(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_to_bigfloat(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::list c_biginteger_from_double(cpp11::doubles x);
+extern "C" SEXP _bignum_c_biginteger_from_double(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_from_double(cpp11::as_cpp<cpp11::decay_t<cpp11::doubles>>(x)));
+  END_CPP11
+}
+// biginteger_interface.cpp
 cpp11::strings c_biginteger_format(cpp11::strings x, cpp11::strings notation);
 extern "C" SEXP _bignum_c_biginteger_format(SEXP x, SEXP notation) {
   BEGIN_CPP11
@@ -398,6 +546,13 @@ extern "C" SEXP _bignum_c_biginteger_compare(SEXP lhs, SEXP rhs, SEXP na_equal)
   END_CPP11
 }
 // biginteger_interface.cpp
+cpp11::logicals c_biginteger_equal(cpp11::strings lhs, cpp11::strings rhs, bool na_equal);
+extern "C" SEXP _bignum_c_biginteger_equal(SEXP lhs, SEXP rhs, SEXP na_equal) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_equal(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(rhs), cpp11::as_cpp<cpp11::decay_t<bool>>(na_equal)));
+  END_CPP11
+}
+// biginteger_interface.cpp
 cpp11::integers c_biginteger_rank(cpp11::strings x);
 extern "C" SEXP _bignum_c_biginteger_rank(SEXP x) {
   BEGIN_CPP11
@@ -447,6 +602,69 @@ extern "C" SEXP _bignum_c_biginteger_quotient(SEXP lhs, SEXP rhs) {
   END_CPP11
 }
 // biginteger_interface.cpp
+cpp11::strings c_biginteger_bitwAnd(cpp11::strings lhs, cpp11::strings rhs);
+extern "C" SEXP _bignum_c_biginteger_bitwAnd(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_bitwAnd(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(rhs)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_bitwOr(cpp11::strings lhs, cpp11::strings rhs);
+extern "C" SEXP _bignum_c_biginteger_bitwOr(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_bitwOr(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(rhs)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_bitwXor(cpp11::strings lhs, cpp11::strings rhs);
+extern "C" SEXP _bignum_c_biginteger_bitwXor(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_bitwXor(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(rhs)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_bitwNot(cpp11::strings x);
+extern "C" SEXP _bignum_c_biginteger_bitwNot(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_bitwNot(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_bitwShiftL(cpp11::strings lhs, cpp11::integers rhs);
+extern "C" SEXP _bignum_c_biginteger_bitwShiftL(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_bitwShiftL(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(rhs)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_bitwShiftR(cpp11::strings lhs, cpp11::integers rhs);
+extern "C" SEXP _bignum_c_biginteger_bitwShiftR(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_bitwShiftR(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(rhs)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::integers c_biginteger_popcount(cpp11::strings x);
+extern "C" SEXP _bignum_c_biginteger_popcount(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_popcount(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::integers c_biginteger_bitlength(cpp11::strings x);
+extern "C" SEXP _bignum_c_biginteger_bitlength(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_bitlength(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::logicals c_biginteger_testbit(cpp11::strings lhs, cpp11::integers rhs);
+extern "C" SEXP _bignum_c_biginteger_testbit(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_testbit(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(rhs)));
+  END_CPP11
+}
+// biginteger_interface.cpp
 cpp11::strings c_biginteger_sum(cpp11::strings x, bool na_rm);
 extern "C" SEXP _bignum_c_biginteger_sum(SEXP x, SEXP na_rm) {
   BEGIN_CPP11
@@ -503,6 +721,111 @@ extern "C" SEXP _bignum_c_biginteger_sign(SEXP lhs) {
   END_CPP11
 }
 // biginteger_interface.cpp
+SEXP c_biginteger_range(cpp11::strings x, bool na_rm);
+extern "C" SEXP _bignum_c_biginteger_range(SEXP x, SEXP na_rm) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_range(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x), cpp11::as_cpp<cpp11::decay_t<bool>>(na_rm)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_mean(cpp11::strings x, bool na_rm);
+extern "C" SEXP _bignum_c_biginteger_mean(SEXP x, SEXP na_rm) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_mean(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x), cpp11::as_cpp<cpp11::decay_t<bool>>(na_rm)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_var(cpp11::strings x, bool na_rm);
+extern "C" SEXP _bignum_c_biginteger_var(SEXP x, SEXP na_rm) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_var(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x), cpp11::as_cpp<cpp11::decay_t<bool>>(na_rm)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::list c_biginteger_summary(cpp11::strings x, bool na_rm);
+extern "C" SEXP _bignum_c_biginteger_summary(SEXP x, SEXP na_rm) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_summary(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x), cpp11::as_cpp<cpp11::decay_t<bool>>(na_rm)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_isqrt(cpp11::strings x);
+extern "C" SEXP _bignum_c_biginteger_isqrt(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_isqrt(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_iroot(cpp11::strings lhs, cpp11::integers rhs);
+extern "C" SEXP _bignum_c_biginteger_iroot(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_iroot(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(rhs)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::logicals c_biginteger_is_square(cpp11::strings x);
+extern "C" SEXP _bignum_c_biginteger_is_square(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_is_square(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::logicals c_biginteger_is_perfect_power(cpp11::strings x);
+extern "C" SEXP _bignum_c_biginteger_is_perfect_power(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_is_perfect_power(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_factorial(cpp11::integers x);
+extern "C" SEXP _bignum_c_biginteger_factorial(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_factorial(cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(x)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_choose(cpp11::strings lhs, cpp11::integers rhs);
+extern "C" SEXP _bignum_c_biginteger_choose(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_choose(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(rhs)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_falling(cpp11::strings lhs, cpp11::integers rhs);
+extern "C" SEXP _bignum_c_biginteger_falling(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_falling(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(rhs)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_rising(cpp11::strings lhs, cpp11::integers rhs);
+extern "C" SEXP _bignum_c_biginteger_rising(SEXP lhs, SEXP rhs) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_rising(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(lhs), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(rhs)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::logicals c_biginteger_is_prime(cpp11::strings x);
+extern "C" SEXP _bignum_c_biginteger_is_prime(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_is_prime(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::strings c_biginteger_next_prime(cpp11::strings x);
+extern "C" SEXP _bignum_c_biginteger_next_prime(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_next_prime(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
+  END_CPP11
+}
+// biginteger_interface.cpp
+cpp11::list c_biginteger_prime_factors(cpp11::strings x);
+extern "C" SEXP _bignum_c_biginteger_prime_factors(SEXP x) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_prime_factors(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x)));
+  END_CPP11
+}
+// biginteger_interface.cpp
 cpp11::strings c_biginteger_seq_to_by(const cpp11::strings& from, const cpp11::strings& to, const cpp11::strings& by);
 extern "C" SEXP _bignum_c_biginteger_seq_to_by(SEXP from, SEXP to, SEXP by) {
   BEGIN_CPP11
@@ -523,89 +846,203 @@ extern "C" SEXP _bignum_c_biginteger_seq_by_lo(SEXP from, SEXP by, SEXP length_o
     return cpp11::as_sexp(c_biginteger_seq_by_lo(cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(from), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(by), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(length_out)));
   END_CPP11
 }
+// cache.cpp
+cpp11::list c_bignum_cache_stats(bool reset);
+extern "C" SEXP _bignum_c_bignum_cache_stats(SEXP reset) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bignum_cache_stats(cpp11::as_cpp<cpp11::decay_t<bool>>(reset)));
+  END_CPP11
+}
+// pillar.cpp
+cpp11::list c_bigfloat_pillar_layout(cpp11::strings x, int sigfig);
+extern "C" SEXP _bignum_c_bigfloat_pillar_layout(SEXP x, SEXP sigfig) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bigfloat_pillar_layout(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x), cpp11::as_cpp<cpp11::decay_t<int>>(sigfig)));
+  END_CPP11
+}
+// pillar.cpp
+cpp11::list c_biginteger_pillar_layout(cpp11::strings x, int sigfig);
+extern "C" SEXP _bignum_c_biginteger_pillar_layout(SEXP x, SEXP sigfig) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_biginteger_pillar_layout(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x), cpp11::as_cpp<cpp11::decay_t<int>>(sigfig)));
+  END_CPP11
+}
+// read_delim.cpp
+cpp11::strings c_read_delim_header(cpp11::strings path, cpp11::strings delim, int skip);
+extern "C" SEXP _bignum_c_read_delim_header(SEXP path, SEXP delim, SEXP skip) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_read_delim_header(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(path), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(delim), cpp11::as_cpp<cpp11::decay_t<int>>(skip)));
+  END_CPP11
+}
+// read_delim.cpp
+cpp11::list c_read_delim_bignum(cpp11::strings path, cpp11::integers cols, cpp11::strings types, cpp11::strings delim, int skip, double chunk_size);
+extern "C" SEXP _bignum_c_read_delim_bignum(SEXP path, SEXP cols, SEXP types, SEXP delim, SEXP skip, SEXP chunk_size) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_read_delim_bignum(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(path), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(cols), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(types), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(delim), cpp11::as_cpp<cpp11::decay_t<int>>(skip), cpp11::as_cpp<cpp11::decay_t<double>>(chunk_size)));
+  END_CPP11
+}
+// serialize.cpp
+void c_biginteger_write(cpp11::strings x, cpp11::strings path);
+extern "C" SEXP _bignum_c_biginteger_write(SEXP x, SEXP path) {
+  BEGIN_CPP11
+    c_biginteger_write(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(path));
+    return R_NilValue;
+  END_CPP11
+}
+// serialize.cpp
+void c_bigfloat_write(cpp11::strings x, cpp11::strings path);
+extern "C" SEXP _bignum_c_bigfloat_write(SEXP x, SEXP path) {
+  BEGIN_CPP11
+    c_bigfloat_write(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(path));
+    return R_NilValue;
+  END_CPP11
+}
+// serialize.cpp
+cpp11::strings c_bignum_read(cpp11::strings path, bool mmap);
+extern "C" SEXP _bignum_c_bignum_read(SEXP path, SEXP mmap) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(c_bignum_read(cpp11::as_cpp<cpp11::decay_t<cpp11::strings>>(path), cpp11::as_cpp<cpp11::decay_t<bool>>(mmap)));
+  END_CPP11
+}
 
 extern "C" {
 static const R_CallMethodDef CallEntries[] = {
-    {"_bignum_c_bigfloat",              (DL_FUNC) &_bignum_c_bigfloat,              1},
-    {"_bignum_c_bigfloat_abs",          (DL_FUNC) &_bignum_c_bigfloat_abs,          1},
-    {"_bignum_c_bigfloat_acos",         (DL_FUNC) &_bignum_c_bigfloat_acos,         1},
-    {"_bignum_c_bigfloat_acosh",        (DL_FUNC) &_bignum_c_bigfloat_acosh,        1},
-    {"_bignum_c_bigfloat_add",          (DL_FUNC) &_bignum_c_bigfloat_add,          2},
-    {"_bignum_c_bigfloat_asin",         (DL_FUNC) &_bignum_c_bigfloat_asin,         1},
-    {"_bignum_c_bigfloat_asinh",        (DL_FUNC) &_bignum_c_bigfloat_asinh,        1},
-    {"_bignum_c_bigfloat_atan",         (DL_FUNC) &_bignum_c_bigfloat_atan,         1},
-    {"_bignum_c_bigfloat_atanh",        (DL_FUNC) &_bignum_c_bigfloat_atanh,        1},
-    {"_bignum_c_bigfloat_ceiling",      (DL_FUNC) &_bignum_c_bigfloat_ceiling,      1},
-    {"_bignum_c_bigfloat_compare",      (DL_FUNC) &_bignum_c_bigfloat_compare,      3},
-    {"_bignum_c_bigfloat_cos",          (DL_FUNC) &_bignum_c_bigfloat_cos,          1},
-    {"_bignum_c_bigfloat_cosh",         (DL_FUNC) &_bignum_c_bigfloat_cosh,         1},
-    {"_bignum_c_bigfloat_cummax",       (DL_FUNC) &_bignum_c_bigfloat_cummax,       1},
-    {"_bignum_c_bigfloat_cummin",       (DL_FUNC) &_bignum_c_bigfloat_cummin,       1},
-    {"_bignum_c_bigfloat_cumprod",      (DL_FUNC) &_bignum_c_bigfloat_cumprod,      1},
-    {"_bignum_c_bigfloat_cumsum",       (DL_FUNC) &_bignum_c_bigfloat_cumsum,       1},
-    {"_bignum_c_bigfloat_digamma",      (DL_FUNC) &_bignum_c_bigfloat_digamma,      1},
-    {"_bignum_c_bigfloat_divide",       (DL_FUNC) &_bignum_c_bigfloat_divide,       2},
-    {"_bignum_c_bigfloat_exp",          (DL_FUNC) &_bignum_c_bigfloat_exp,          1},
-    {"_bignum_c_bigfloat_expm1",        (DL_FUNC) &_bignum_c_bigfloat_expm1,        1},
-    {"_bignum_c_bigfloat_floor",        (DL_FUNC) &_bignum_c_bigfloat_floor,        1},
-    {"_bignum_c_bigfloat_format",       (DL_FUNC) &_bignum_c_bigfloat_format,       4},
-    {"_bignum_c_bigfloat_gamma",        (DL_FUNC) &_bignum_c_bigfloat_gamma,        1},
-    {"_bignum_c_bigfloat_lgamma",       (DL_FUNC) &_bignum_c_bigfloat_lgamma,       1},
-    {"_bignum_c_bigfloat_log",          (DL_FUNC) &_bignum_c_bigfloat_log,          1},
-    {"_bignum_c_bigfloat_log10",        (DL_FUNC) &_bignum_c_bigfloat_log10,        1},
-    {"_bignum_c_bigfloat_log1p",        (DL_FUNC) &_bignum_c_bigfloat_log1p,        1},
-    {"_bignum_c_bigfloat_log2",         (DL_FUNC) &_bignum_c_bigfloat_log2,         1},
-    {"_bignum_c_bigfloat_modulo",       (DL_FUNC) &_bignum_c_bigfloat_modulo,       2},
-    {"_bignum_c_bigfloat_multiply",     (DL_FUNC) &_bignum_c_bigfloat_multiply,     2},
-    {"_bignum_c_bigfloat_pow",          (DL_FUNC) &_bignum_c_bigfloat_pow,          2},
-    {"_bignum_c_bigfloat_prod",         (DL_FUNC) &_bignum_c_bigfloat_prod,         2},
-    {"_bignum_c_bigfloat_rank",         (DL_FUNC) &_bignum_c_bigfloat_rank,         1},
-    {"_bignum_c_bigfloat_seq_by_lo",    (DL_FUNC) &_bignum_c_bigfloat_seq_by_lo,    3},
-    {"_bignum_c_bigfloat_seq_to_by",    (DL_FUNC) &_bignum_c_bigfloat_seq_to_by,    3},
-    {"_bignum_c_bigfloat_seq_to_lo",    (DL_FUNC) &_bignum_c_bigfloat_seq_to_lo,    3},
-    {"_bignum_c_bigfloat_sign",         (DL_FUNC) &_bignum_c_bigfloat_sign,         1},
-    {"_bignum_c_bigfloat_sin",          (DL_FUNC) &_bignum_c_bigfloat_sin,          1},
-    {"_bignum_c_bigfloat_sinh",         (DL_FUNC) &_bignum_c_bigfloat_sinh,         1},
-    {"_bignum_c_bigfloat_sqrt",         (DL_FUNC) &_bignum_c_bigfloat_sqrt,         1},
-    {"_bignum_c_bigfloat_subtract",     (DL_FUNC) &_bignum_c_bigfloat_subtract,     2},
-    {"_bignum_c_bigfloat_sum",          (DL_FUNC) &_bignum_c_bigfloat_sum,          2},
-    {"_bignum_c_bigfloat_tan",          (DL_FUNC) &_bignum_c_bigfloat_tan,          1},
-    {"_bignum_c_bigfloat_tanh",         (DL_FUNC) &_bignum_c_bigfloat_tanh,         1},
-    {"_bignum_c_bigfloat_to_double",    (DL_FUNC) &_bignum_c_bigfloat_to_double,    1},
-    {"_bignum_c_bigfloat_to_integer",   (DL_FUNC) &_bignum_c_bigfloat_to_integer,   1},
-    {"_bignum_c_bigfloat_to_logical",   (DL_FUNC) &_bignum_c_bigfloat_to_logical,   1},
-    {"_bignum_c_bigfloat_trigamma",     (DL_FUNC) &_bignum_c_bigfloat_trigamma,     1},
-    {"_bignum_c_bigfloat_trunc",        (DL_FUNC) &_bignum_c_bigfloat_trunc,        1},
-    {"_bignum_c_biginteger",            (DL_FUNC) &_bignum_c_biginteger,            1},
-    {"_bignum_c_biginteger_abs",        (DL_FUNC) &_bignum_c_biginteger_abs,        1},
-    {"_bignum_c_biginteger_add",        (DL_FUNC) &_bignum_c_biginteger_add,        2},
-    {"_bignum_c_biginteger_compare",    (DL_FUNC) &_bignum_c_biginteger_compare,    3},
-    {"_bignum_c_biginteger_cummax",     (DL_FUNC) &_bignum_c_biginteger_cummax,     1},
-    {"_bignum_c_biginteger_cummin",     (DL_FUNC) &_bignum_c_biginteger_cummin,     1},
-    {"_bignum_c_biginteger_cumprod",    (DL_FUNC) &_bignum_c_biginteger_cumprod,    1},
-    {"_bignum_c_biginteger_cumsum",     (DL_FUNC) &_bignum_c_biginteger_cumsum,     1},
-    {"_bignum_c_biginteger_format",     (DL_FUNC) &_bignum_c_biginteger_format,     2},
-    {"_bignum_c_biginteger_modulo",     (DL_FUNC) &_bignum_c_biginteger_modulo,     2},
-    {"_bignum_c_biginteger_multiply",   (DL_FUNC) &_bignum_c_biginteger_multiply,   2},
-    {"_bignum_c_biginteger_pow",        (DL_FUNC) &_bignum_c_biginteger_pow,        2},
-    {"_bignum_c_biginteger_prod",       (DL_FUNC) &_bignum_c_biginteger_prod,       2},
-    {"_bignum_c_biginteger_quotient",   (DL_FUNC) &_bignum_c_biginteger_quotient,   2},
-    {"_bignum_c_biginteger_rank",       (DL_FUNC) &_bignum_c_biginteger_rank,       1},
-    {"_bignum_c_biginteger_seq_by_lo",  (DL_FUNC) &_bignum_c_biginteger_seq_by_lo,  3},
-    {"_bignum_c_biginteger_seq_to_by",  (DL_FUNC) &_bignum_c_biginteger_seq_to_by,  3},
-    {"_bignum_c_biginteger_seq_to_lo",  (DL_FUNC) &_bignum_c_biginteger_seq_to_lo,  3},
-    {"_bignum_c_biginteger_sign",       (DL_FUNC) &_bignum_c_biginteger_sign,       1},
-    {"_bignum_c_biginteger_subtract",   (DL_FUNC) &_bignum_c_biginteger_subtract,   2},
-    {"_bignum_c_biginteger_sum",        (DL_FUNC) &_bignum_c_biginteger_sum,        2},
-    {"_bignum_c_biginteger_to_double",  (DL_FUNC) &_bignum_c_biginteger_to_double,  1},
-    {"_bignum_c_biginteger_to_integer", (DL_FUNC) &_bignum_c_biginteger_to_integer, 1},
-    {"_bignum_c_biginteger_to_logical", (DL_FUNC) &_bignum_c_biginteger_to_logical, 1},
+    {"_bignum_c_accumulator_merge",           (DL_FUNC) &_bignum_c_accumulator_merge,           2},
+    {"_bignum_c_accumulator_new",             (DL_FUNC) &_bignum_c_accumulator_new,             3},
+    {"_bignum_c_accumulator_result",          (DL_FUNC) &_bignum_c_accumulator_result,          1},
+    {"_bignum_c_accumulator_update",          (DL_FUNC) &_bignum_c_accumulator_update,          2},
+    {"_bignum_c_bigfloat",                    (DL_FUNC) &_bignum_c_bigfloat,                    1},
+    {"_bignum_c_bigfloat_abs",                (DL_FUNC) &_bignum_c_bigfloat_abs,                1},
+    {"_bignum_c_bigfloat_acos",               (DL_FUNC) &_bignum_c_bigfloat_acos,               1},
+    {"_bignum_c_bigfloat_acosh",              (DL_FUNC) &_bignum_c_bigfloat_acosh,              1},
+    {"_bignum_c_bigfloat_add",                (DL_FUNC) &_bignum_c_bigfloat_add,                2},
+    {"_bignum_c_bigfloat_arith_mixed",        (DL_FUNC) &_bignum_c_bigfloat_arith_mixed,        3},
+    {"_bignum_c_bigfloat_asin",               (DL_FUNC) &_bignum_c_bigfloat_asin,               1},
+    {"_bignum_c_bigfloat_asinh",              (DL_FUNC) &_bignum_c_bigfloat_asinh,              1},
+    {"_bignum_c_bigfloat_atan",               (DL_FUNC) &_bignum_c_bigfloat_atan,               1},
+    {"_bignum_c_bigfloat_atan2",              (DL_FUNC) &_bignum_c_bigfloat_atan2,              2},
+    {"_bignum_c_bigfloat_atanh",              (DL_FUNC) &_bignum_c_bigfloat_atanh,              1},
+    {"_bignum_c_bigfloat_ceiling",            (DL_FUNC) &_bignum_c_bigfloat_ceiling,            1},
+    {"_bignum_c_bigfloat_compare",            (DL_FUNC) &_bignum_c_bigfloat_compare,            3},
+    {"_bignum_c_bigfloat_compare_mixed",      (DL_FUNC) &_bignum_c_bigfloat_compare_mixed,      4},
+    {"_bignum_c_bigfloat_cos",                (DL_FUNC) &_bignum_c_bigfloat_cos,                1},
+    {"_bignum_c_bigfloat_cosh",               (DL_FUNC) &_bignum_c_bigfloat_cosh,               1},
+    {"_bignum_c_bigfloat_cospi",              (DL_FUNC) &_bignum_c_bigfloat_cospi,              1},
+    {"_bignum_c_bigfloat_cummax",             (DL_FUNC) &_bignum_c_bigfloat_cummax,             1},
+    {"_bignum_c_bigfloat_cummin",             (DL_FUNC) &_bignum_c_bigfloat_cummin,             1},
+    {"_bignum_c_bigfloat_cumprod",            (DL_FUNC) &_bignum_c_bigfloat_cumprod,            1},
+    {"_bignum_c_bigfloat_cumsum",             (DL_FUNC) &_bignum_c_bigfloat_cumsum,             1},
+    {"_bignum_c_bigfloat_digamma",            (DL_FUNC) &_bignum_c_bigfloat_digamma,            1},
+    {"_bignum_c_bigfloat_divide",             (DL_FUNC) &_bignum_c_bigfloat_divide,             2},
+    {"_bignum_c_bigfloat_exp",                (DL_FUNC) &_bignum_c_bigfloat_exp,                1},
+    {"_bignum_c_bigfloat_expm1",              (DL_FUNC) &_bignum_c_bigfloat_expm1,              1},
+    {"_bignum_c_bigfloat_floor",              (DL_FUNC) &_bignum_c_bigfloat_floor,              1},
+    {"_bignum_c_bigfloat_fma",                (DL_FUNC) &_bignum_c_bigfloat_fma,                3},
+    {"_bignum_c_bigfloat_format",             (DL_FUNC) &_bignum_c_bigfloat_format,             4},
+    {"_bignum_c_bigfloat_gamma",              (DL_FUNC) &_bignum_c_bigfloat_gamma,              1},
+    {"_bignum_c_bigfloat_hypot",              (DL_FUNC) &_bignum_c_bigfloat_hypot,              2},
+    {"_bignum_c_bigfloat_is_na",              (DL_FUNC) &_bignum_c_bigfloat_is_na,              1},
+    {"_bignum_c_bigfloat_lgamma",             (DL_FUNC) &_bignum_c_bigfloat_lgamma,             1},
+    {"_bignum_c_bigfloat_log",                (DL_FUNC) &_bignum_c_bigfloat_log,                1},
+    {"_bignum_c_bigfloat_log10",              (DL_FUNC) &_bignum_c_bigfloat_log10,              1},
+    {"_bignum_c_bigfloat_log1p",              (DL_FUNC) &_bignum_c_bigfloat_log1p,              1},
+    {"_bignum_c_bigfloat_log2",               (DL_FUNC) &_bignum_c_bigfloat_log2,               1},
+    {"_bignum_c_bigfloat_log_base",           (DL_FUNC) &_bignum_c_bigfloat_log_base,           2},
+    {"_bignum_c_bigfloat_mean",               (DL_FUNC) &_bignum_c_bigfloat_mean,               2},
+    {"_bignum_c_bigfloat_modulo",             (DL_FUNC) &_bignum_c_bigfloat_modulo,             2},
+    {"_bignum_c_bigfloat_multiply",           (DL_FUNC) &_bignum_c_bigfloat_multiply,           2},
+    {"_bignum_c_bigfloat_pillar_layout",      (DL_FUNC) &_bignum_c_bigfloat_pillar_layout,      2},
+    {"_bignum_c_bigfloat_pow",                (DL_FUNC) &_bignum_c_bigfloat_pow,                2},
+    {"_bignum_c_bigfloat_prod",               (DL_FUNC) &_bignum_c_bigfloat_prod,               2},
+    {"_bignum_c_bigfloat_range",              (DL_FUNC) &_bignum_c_bigfloat_range,              2},
+    {"_bignum_c_bigfloat_rank",               (DL_FUNC) &_bignum_c_bigfloat_rank,               1},
+    {"_bignum_c_bigfloat_seq_by_lo",          (DL_FUNC) &_bignum_c_bigfloat_seq_by_lo,          3},
+    {"_bignum_c_bigfloat_seq_to_by",          (DL_FUNC) &_bignum_c_bigfloat_seq_to_by,          3},
+    {"_bignum_c_bigfloat_seq_to_lo",          (DL_FUNC) &_bignum_c_bigfloat_seq_to_lo,          3},
+    {"_bignum_c_bigfloat_sign",               (DL_FUNC) &_bignum_c_bigfloat_sign,               1},
+    {"_bignum_c_bigfloat_sin",                (DL_FUNC) &_bignum_c_bigfloat_sin,                1},
+    {"_bignum_c_bigfloat_sinh",               (DL_FUNC) &_bignum_c_bigfloat_sinh,               1},
+    {"_bignum_c_bigfloat_sinpi",              (DL_FUNC) &_bignum_c_bigfloat_sinpi,              1},
+    {"_bignum_c_bigfloat_sqrt",               (DL_FUNC) &_bignum_c_bigfloat_sqrt,               1},
+    {"_bignum_c_bigfloat_subtract",           (DL_FUNC) &_bignum_c_bigfloat_subtract,           2},
+    {"_bignum_c_bigfloat_sum",                (DL_FUNC) &_bignum_c_bigfloat_sum,                2},
+    {"_bignum_c_bigfloat_summary",            (DL_FUNC) &_bignum_c_bigfloat_summary,            2},
+    {"_bignum_c_bigfloat_tan",                (DL_FUNC) &_bignum_c_bigfloat_tan,                1},
+    {"_bignum_c_bigfloat_tanh",               (DL_FUNC) &_bignum_c_bigfloat_tanh,               1},
+    {"_bignum_c_bigfloat_tanpi",              (DL_FUNC) &_bignum_c_bigfloat_tanpi,              1},
+    {"_bignum_c_bigfloat_to_biginteger",      (DL_FUNC) &_bignum_c_bigfloat_to_biginteger,      1},
+    {"_bignum_c_bigfloat_to_double",          (DL_FUNC) &_bignum_c_bigfloat_to_double,          1},
+    {"_bignum_c_bigfloat_to_integer",         (DL_FUNC) &_bignum_c_bigfloat_to_integer,         1},
+    {"_bignum_c_bigfloat_to_logical",         (DL_FUNC) &_bignum_c_bigfloat_to_logical,         1},
+    {"_bignum_c_bigfloat_trigamma",           (DL_FUNC) &_bignum_c_bigfloat_trigamma,           1},
+    {"_bignum_c_bigfloat_trunc",              (DL_FUNC) &_bignum_c_bigfloat_trunc,              1},
+    {"_bignum_c_bigfloat_var",                (DL_FUNC) &_bignum_c_bigfloat_var,                2},
+    {"_bignum_c_bigfloat_write",              (DL_FUNC) &_bignum_c_bigfloat_write,              2},
+    {"_bignum_c_biginteger",                  (DL_FUNC) &_bignum_c_biginteger,                  1},
+    {"_bignum_c_biginteger_abs",              (DL_FUNC) &_bignum_c_biginteger_abs,              1},
+    {"_bignum_c_biginteger_add",              (DL_FUNC) &_bignum_c_biginteger_add,              2},
+    {"_bignum_c_biginteger_bitlength",        (DL_FUNC) &_bignum_c_biginteger_bitlength,        1},
+    {"_bignum_c_biginteger_bitwAnd",          (DL_FUNC) &_bignum_c_biginteger_bitwAnd,          2},
+    {"_bignum_c_biginteger_bitwNot",          (DL_FUNC) &_bignum_c_biginteger_bitwNot,          1},
+    {"_bignum_c_biginteger_bitwOr",           (DL_FUNC) &_bignum_c_biginteger_bitwOr,           2},
+    {"_bignum_c_biginteger_bitwShiftL",       (DL_FUNC) &_bignum_c_biginteger_bitwShiftL,       2},
+    {"_bignum_c_biginteger_bitwShiftR",       (DL_FUNC) &_bignum_c_biginteger_bitwShiftR,       2},
+    {"_bignum_c_biginteger_bitwXor",          (DL_FUNC) &_bignum_c_biginteger_bitwXor,          2},
+    {"_bignum_c_biginteger_choose",           (DL_FUNC) &_bignum_c_biginteger_choose,           2},
+    {"_bignum_c_biginteger_compare",          (DL_FUNC) &_bignum_c_biginteger_compare,          3},
+    {"_bignum_c_biginteger_cummax",           (DL_FUNC) &_bignum_c_biginteger_cummax,           1},
+    {"_bignum_c_biginteger_cummin",           (DL_FUNC) &_bignum_c_biginteger_cummin,           1},
+    {"_bignum_c_biginteger_cumprod",          (DL_FUNC) &_bignum_c_biginteger_cumprod,          1},
+    {"_bignum_c_biginteger_cumsum",           (DL_FUNC) &_bignum_c_biginteger_cumsum,           1},
+    {"_bignum_c_biginteger_equal",            (DL_FUNC) &_bignum_c_biginteger_equal,            3},
+    {"_bignum_c_biginteger_factorial",        (DL_FUNC) &_bignum_c_biginteger_factorial,        1},
+    {"_bignum_c_biginteger_falling",          (DL_FUNC) &_bignum_c_biginteger_falling,          2},
+    {"_bignum_c_biginteger_format",           (DL_FUNC) &_bignum_c_biginteger_format,           2},
+    {"_bignum_c_biginteger_from_double",      (DL_FUNC) &_bignum_c_biginteger_from_double,      1},
+    {"_bignum_c_biginteger_iroot",            (DL_FUNC) &_bignum_c_biginteger_iroot,            2},
+    {"_bignum_c_biginteger_is_perfect_power", (DL_FUNC) &_bignum_c_biginteger_is_perfect_power, 1},
+    {"_bignum_c_biginteger_is_prime",         (DL_FUNC) &_bignum_c_biginteger_is_prime,         1},
+    {"_bignum_c_biginteger_is_square",        (DL_FUNC) &_bignum_c_biginteger_is_square,        1},
+    {"_bignum_c_biginteger_isqrt",            (DL_FUNC) &_bignum_c_biginteger_isqrt,            1},
+    {"_bignum_c_biginteger_mean",             (DL_FUNC) &_bignum_c_biginteger_mean,             2},
+    {"_bignum_c_biginteger_modulo",           (DL_FUNC) &_bignum_c_biginteger_modulo,           2},
+    {"_bignum_c_biginteger_multiply",         (DL_FUNC) &_bignum_c_biginteger_multiply,         2},
+    {"_bignum_c_biginteger_next_prime",       (DL_FUNC) &_bignum_c_biginteger_next_prime,       1},
+    {"_bignum_c_biginteger_pillar_layout",    (DL_FUNC) &_bignum_c_biginteger_pillar_layout,    2},
+    {"_bignum_c_biginteger_popcount",         (DL_FUNC) &_bignum_c_biginteger_popcount,         1},
+    {"_bignum_c_biginteger_pow",              (DL_FUNC) &_bignum_c_biginteger_pow,              2},
+    {"_bignum_c_biginteger_prime_factors",    (DL_FUNC) &_bignum_c_biginteger_prime_factors,    1},
+    {"_bignum_c_biginteger_prod",             (DL_FUNC) &_bignum_c_biginteger_prod,             2},
+    {"_bignum_c_biginteger_quotient",         (DL_FUNC) &_bignum_c_biginteger_quotient,         2},
+    {"_bignum_c_biginteger_range",            (DL_FUNC) &_bignum_c_biginteger_range,            2},
+    {"_bignum_c_biginteger_rank",             (DL_FUNC) &_bignum_c_biginteger_rank,             1},
+    {"_bignum_c_biginteger_rising",           (DL_FUNC) &_bignum_c_biginteger_rising,           2},
+    {"_bignum_c_biginteger_seq_by_lo",        (DL_FUNC) &_bignum_c_biginteger_seq_by_lo,        3},
+    {"_bignum_c_biginteger_seq_to_by",        (DL_FUNC) &_bignum_c_biginteger_seq_to_by,        3},
+    {"_bignum_c_biginteger_seq_to_lo",        (DL_FUNC) &_bignum_c_biginteger_seq_to_lo,        3},
+    {"_bignum_c_biginteger_sign",             (DL_FUNC) &_bignum_c_biginteger_sign,             1},
+    {"_bignum_c_biginteger_subtract",         (DL_FUNC) &_bignum_c_biginteger_subtract,         2},
+    {"_bignum_c_biginteger_sum",              (DL_FUNC) &_bignum_c_biginteger_sum,              2},
+    {"_bignum_c_biginteger_summary",          (DL_FUNC) &_bignum_c_biginteger_summary,          2},
+    {"_bignum_c_biginteger_testbit",          (DL_FUNC) &_bignum_c_biginteger_testbit,          2},
+    {"_bignum_c_biginteger_to_bigfloat",      (DL_FUNC) &_bignum_c_biginteger_to_bigfloat,      1},
+    {"_bignum_c_biginteger_to_double",        (DL_FUNC) &_bignum_c_biginteger_to_double,        1},
+    {"_bignum_c_biginteger_to_integer",       (DL_FUNC) &_bignum_c_biginteger_to_integer,       1},
+    {"_bignum_c_biginteger_to_logical",       (DL_FUNC) &_bignum_c_biginteger_to_logical,       1},
+    {"_bignum_c_biginteger_var",              (DL_FUNC) &_bignum_c_biginteger_var,              2},
+    {"_bignum_c_biginteger_write",            (DL_FUNC) &_bignum_c_biginteger_write,            2},
+    {"_bignum_c_bignum_cache_stats",          (DL_FUNC) &_bignum_c_bignum_cache_stats,          1},
+    {"_bignum_c_bignum_read",                 (DL_FUNC) &_bignum_c_bignum_read,                 2},
+    {"_bignum_c_read_delim_bignum",           (DL_FUNC) &_bignum_c_read_delim_bignum,           6},
+    {"_bignum_c_read_delim_header",           (DL_FUNC) &_bignum_c_read_delim_header,           3},
     {NULL, NULL, 0}
 };
 }
 
+void init_lazy_strings(DllInfo* dll);
 extern "C" attribute_visible void R_init_bignum(DllInfo* dll){
   R_registerRoutines(dll, NULL, CallEntries, NULL, NULL);
   R_useDynamicSymbols(dll, FALSE);
+  init_lazy_strings(dll);
   R_forceSymbols(dll, TRUE);
 }
@@ -0,0 +1,214 @@
+#ifndef __BIGNUM_FIXED_WIDTH__
+#define __BIGNUM_FIXED_WIDTH__
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <type_traits>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/integer.hpp>
+#include "biginteger_vector.h"
+#include "operations.h"
+#include "multiply.h"
+
+/*
+ * Fixed-width kernels: biginteger values are arbitrary-width integers, but
+ * many columns (hashes, IDs, fixed-point money) fit in a few machine words.
+ * Before an element loop, the widest operand is measured and, if every
+ * result is guaranteed to fit, the loop runs on a 128, 256 or 512-bit
+ * integer instead, which never allocates.
+ *
+ * Values are still stored at arbitrary width, so each element is converted
+ * on the way in and out. That costs about as much as one addition, so only
+ * kernels doing several operations per element (e.g. pow) benefit.
+ *
+ * The fixed-width types are checked, so an unexpected overflow falls back
+ * to the arbitrary-width result for that element.
+ */
+
+// Number of bits in the magnitude of `x` (0 for zero)
+inline std::size_t bit_width(const biginteger_type &x) {
+  const std::size_t n_limbs = x.backend().size();
+  const boost::multiprecision::limb_type top = x.backend().limbs()[n_limbs - 1];
+
+  const std::size_t bits = (n_limbs - 1) * sizeof(top) * CHAR_BIT;
+  return top == 0 ? bits : bits + boost::multiprecision::msb(top) + 1;
+}
+
+inline std::size_t max_bit_width(const biginteger_vector &x) {
+  std::size_t bits = 0;
+  for (std::size_t i=0; i<x.size(); ++i) {
+    if (!x.is_na[i]) {
+      bits = std::max(bits, bit_width(x.data[i]));
+    }
+  }
+  return bits;
+}
+
+/*
+ * Conversions copy limbs directly, which is much cheaper than the generic
+ * conversion between backends. The value must fit in the destination.
+ *
+ * When the compiler has a 128-bit integer, a 128-bit cpp_int is "trivial":
+ * it stores a single double-width limb, so limbs are combined with shifts.
+ */
+template<class Fixed>
+struct is_trivial_fixed_width : std::integral_constant<bool,
+  boost::multiprecision::backends::is_trivial_cpp_int<typename Fixed::backend_type>::value> {};
+
+template<class Fixed>
+Fixed to_fixed_width(const biginteger_type &x, std::false_type) {
+  Fixed output;
+  const std::size_t n_limbs = x.backend().size();
+  output.backend().resize(n_limbs, n_limbs);
+  std::copy(x.backend().limbs(), x.backend().limbs() + n_limbs, output.backend().limbs());
+  output.backend().sign(x.backend().sign());
+  output.backend().normalize();
+  return output;
+}
+
+template<class Fixed>
+Fixed to_fixed_width(const biginteger_type &x, std::true_type) {
+  const std::size_t limb_bits = sizeof(boost::multiprecision::limb_type) * CHAR_BIT;
+  const std::size_t n_limbs = x.backend().size();
+
+  Fixed output(x.backend().limbs()[n_limbs - 1]);
+  for (std::size_t k=n_limbs - 1; k>0; --k) {
+    output <<= limb_bits;
+    output |= Fixed(x.backend().limbs()[k - 1]);
+  }
+  return x.backend().sign() ? Fixed(-output) : output;
+}
+
+template<class Fixed>
+Fixed to_fixed_width(const biginteger_type &x) {
+  return to_fixed_width<Fixed>(x, is_trivial_fixed_width<Fixed>());
+}
+
+template<class Fixed>
+biginteger_type from_fixed_width(const Fixed &x, std::false_type) {
+  biginteger_type output;
+  const std::size_t n_limbs = x.backend().size();
+  output.backend().resize(n_limbs, n_limbs);
+  std::copy(x.backend().limbs(), x.backend().limbs() + n_limbs, output.backend().limbs());
+  output.backend().sign(x.backend().sign());
+  output.backend().normalize();
+  return output;
+}
+
+template<class Fixed>
+biginteger_type from_fixed_width(const Fixed &x, std::true_type) {
+  typedef boost::multiprecision::limb_type limb_type;
+  const std::size_t limb_bits = sizeof(limb_type) * CHAR_BIT;
+  const Fixed magnitude = x < 0 ? Fixed(-x) : x;
+  const Fixed mask(~limb_type(0));
+
+  biginteger_type output;
+  output.backend().resize(2, 2);
+  output.backend().limbs()[0] = Fixed(magnitude & mask).template convert_to<limb_type>();
+  output.backend().limbs()[1] = Fixed(magnitude >> limb_bits).template convert_to<limb_type>();
+  output.backend().sign(x < 0);
+  output.backend().normalize();
+  return output;
+}
+
+template<class Fixed>
+biginteger_type from_fixed_width(const Fixed &x) {
+  return from_fixed_width(x, is_trivial_fixed_width<Fixed>());
+}
+
+// Operands of a kernel: a biginteger vector, or R integers (e.g. exponents)
+inline bool operand_is_na(const biginteger_vector &x, std::size_t i) { return x.is_na[i]; }
+inline bool operand_is_na(const cpp11::integers &x, std::size_t i) { return x[i] == NA_INTEGER; }
+
+template<class Fixed>
+Fixed fixed_width_operand(const biginteger_vector &x, std::size_t i) { return to_fixed_width<Fixed>(x.data[i]); }
+template<class Fixed>
+int fixed_width_operand(const cpp11::integers &x, std::size_t i) { return x[i]; }
+
+inline const biginteger_type& operand(const biginteger_vector &x, std::size_t i) { return x.data[i]; }
+inline int operand(const cpp11::integers &x, std::size_t i) { return x[i]; }
+
+// Magnitude of the largest operand: bits of a biginteger, value of an integer
+inline std::size_t operand_magnitude(const biginteger_vector &x) {
+  return max_bit_width(x);
+}
+
+inline std::size_t operand_magnitude(const cpp11::integers &x) {
+  std::size_t magnitude = 0;
+  for (R_xlen_t i=0; i<x.size(); ++i) {
+    if (x[i] != NA_INTEGER) {
+      magnitude = std::max(magnitude, static_cast<std::size_t>(std::abs(x[i])));
+    }
+  }
+  return magnitude;
+}
+
+/*
+ * Operations usable at any width, with a bound on the width of the result:
+ *
+ *   struct op {
+ *     static std::size_t result_bits(std::size_t lhs, std::size_t rhs);
+ *     template<class T> T operator()(const T &x, ...) const;
+ *   };
+ */
+struct fixed_width_pow {
+  static std::size_t result_bits(std::size_t bits, std::size_t exponent) {
+    return std::max<std::size_t>(bits * exponent, 1);
+  }
+  template<class T> T operator()(const T &x, int y) const { return boost::multiprecision::pow(x, y); }
+  // Large results use fast multiplication
+  biginteger_type operator()(const biginteger_type &x, int y) const {
+    return y < 0 ? biginteger_type(boost::multiprecision::pow(x, y)) : fast_pow(x, y);
+  }
+};
+
+template<class Fixed, class Rhs, class Op>
+biginteger_vector fixed_width_loop(const biginteger_vector &lhs, const Rhs &rhs, const Op &op) {
+  biginteger_vector output(lhs.size());
+
+  for (interrupt_blocks block(lhs.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (operand_is_na(lhs, i) || operand_is_na(rhs, i)) {
+        output.is_na[i] = true;
+        continue;
+      }
+
+      try {
+        const Fixed result = op(fixed_width_operand<Fixed>(lhs, i), fixed_width_operand<Fixed>(rhs, i));
+        output.data[i] = from_fixed_width(result);
+      } catch (...) {
+        try {
+          output.data[i] = op(operand(lhs, i), operand(rhs, i));
+        } catch (...) {
+          output.is_na[i] = true;
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+// binary_operation(), using the narrowest width that holds every result
+template<class Rhs, class Op>
+biginteger_vector fixed_width_operation(const biginteger_vector &lhs, const Rhs &rhs, const Op &op) {
+  if (lhs.size() != static_cast<std::size_t>(rhs.size())) {
+    cpp11::stop("Incompatible sizes"); // # nocov
+  }
+
+  namespace mp = boost::multiprecision;
+  const std::size_t bits = Op::result_bits(operand_magnitude(lhs), operand_magnitude(rhs));
+
+  if (bits <= 128) {
+    return fixed_width_loop<mp::checked_int128_t>(lhs, rhs, op);
+  } else if (bits <= 256) {
+    return fixed_width_loop<mp::checked_int256_t>(lhs, rhs, op);
+  } else if (bits <= 512) {
+    return fixed_width_loop<mp::checked_int512_t>(lhs, rhs, op);
+  } else {
+    return binary_operation(lhs, rhs, op);
+  }
+}
+
+#endif
@@ -1,4 +1,53 @@
+#include <unordered_set>
 #include "format.h"
+#include "cache.h"
+#include "interrupt.h"
+
+
+// Remembers the first index of each distinct value, so repeated values can
+// reuse the string that was already formatted. Values are compared by sign
+// too, so that -0 and 0 stay distinct.
+template<class T>
+class format_cache {
+public:
+  format_cache(const std::vector<T> &data)
+    : policy(encode_cache_counter(), data.size()),
+      seen(16, index_hash(data), index_equal(data)) {}
+
+  // Returns true (and sets `first`) if the value at `i` was already seen.
+  bool find(std::size_t i, std::size_t &first) {
+    if (!policy.active()) {
+      return false;
+    }
+
+    std::pair<typename std::unordered_set<std::size_t, index_hash, index_equal>::iterator, bool> found =
+      seen.insert(i);
+    first = *found.first;
+
+    if (!policy.record(!found.second)) {
+      seen.clear();
+    }
+    return !found.second;
+  }
+
+private:
+  struct index_hash {
+    index_hash(const std::vector<T> &data) : data(data) {}
+    std::size_t operator()(std::size_t i) const { return std::hash<T>()(data[i]); }
+    const std::vector<T> &data;
+  };
+
+  struct index_equal {
+    index_equal(const std::vector<T> &data) : data(data) {}
+    bool operator()(std::size_t i, std::size_t j) const {
+      return data[i] == data[j] && data[i].backend().sign() == data[j].backend().sign();
+    }
+    const std::vector<T> &data;
+  };
+
+  cache_policy policy;
+  std::unordered_set<std::size_t, index_hash, index_equal> seen;
+};
 
 
 enum bignum_format_notation format_notation(const std::string &input) {
@@ -11,6 +60,7 @@ enum bignum_format_notation format_notation(const std::string &input) {
 cpp11::strings format_biginteger_vector(const biginteger_vector &x,
                                         enum bignum_format_notation notation) {
   cpp11::writable::strings output(x.size());
+  format_cache<biginteger_type> cache(x.data);
   std::stringstream ss;
 
   switch (notation) {
@@ -24,19 +74,21 @@ cpp11::strings format_biginteger_vector(const biginteger_vector &x,
     cpp11::stop("Found unexpected formatting notation."); // # nocov
   }
 
-  for (std::size_t i=0; i<x.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
-
-    if (x.is_na[i]) {
-      output[i] = NA_STRING;
-    } else if (notation == bignum_format_hex && x.data[i] < 0) {
-      output[i] = NA_STRING;
-    } else {
-      ss << x.data[i];
-      output[i] = ss.str();
-      ss.str("");
+  for (interrupt_blocks block(x.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      std::size_t first;
+      if (x.is_na[i]) {
+        output[i] = NA_STRING;
+      } else if (notation == bignum_format_hex && x.data[i] < 0) {
+        output[i] = NA_STRING;
+      } else if (cache.find(i, first)) {
+        cpp11::r_string value = output[first];
+        output[i] = value;
+      } else {
+        ss << x.data[i];
+        output[i] = ss.str();
+        ss.str("");
+      }
     }
   }
 
@@ -47,20 +99,23 @@ cpp11::strings format_bigfloat_vector(const bigfloat_vector &x,
                                       enum bignum_format_notation notation,
                                       int digits, bool is_sigfig) {
   cpp11::writable::strings output(x.size());
-
-  for (std::size_t i=0; i<x.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
-
-    if (x.is_na[i]) {
-      output[i] = NA_STRING;
-    } else if (boost::multiprecision::isnan(x.data[i])) {
-      output[i] = "NaN";
-    } else if (isinf(x.data[i])) {
-      output[i] = x.data[i] > 0 ? "Inf" : "-Inf";
-    } else {
-      output[i] = format_bigfloat(x.data[i], notation, digits, is_sigfig);
+  format_cache<bigfloat_type> cache(x.data);
+
+  for (interrupt_blocks block(x.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      std::size_t first;
+      if (x.is_na[i]) {
+        output[i] = NA_STRING;
+      } else if (boost::multiprecision::isnan(x.data[i])) {
+        output[i] = "NaN";
+      } else if (isinf(x.data[i])) {
+        output[i] = x.data[i] > 0 ? "Inf" : "-Inf";
+      } else if (cache.find(i, first)) {
+        cpp11::r_string value = output[first];
+        output[i] = value;
+      } else {
+        output[i] = format_bigfloat(x.data[i], notation, digits, is_sigfig);
+      }
     }
   }
 
@@ -0,0 +1,29 @@
+#include <atomic>
+#include <thread>
+#include "interrupt.h"
+#include "options.h"
+
+// Static initialization runs while R loads the shared library
+static const std::thread::id main_thread_id = std::this_thread::get_id();
+
+static const std::size_t default_block_size = 8192;
+static std::atomic<std::size_t> block_size(default_block_size);
+
+
+bool is_main_thread() {
+  return std::this_thread::get_id() == main_thread_id;
+}
+
+void check_interrupt() {
+  if (is_main_thread()) {
+    cpp11::check_user_interrupt();
+  }
+}
+
+std::size_t interrupt_block_size() {
+  if (is_main_thread()) {
+    int value = option_int("bignum.interrupt_block_size", default_block_size);
+    block_size = value < 1 ? default_block_size : value;
+  }
+  return block_size;
+}
@@ -0,0 +1,64 @@
+#ifndef __BIGNUM_INTERRUPT__
+#define __BIGNUM_INTERRUPT__
+
+#include <algorithm>
+#include <cstddef>
+#include <cpp11.hpp>
+
+/*
+ * Element loops are split into blocks, with a check for user interrupts
+ * between blocks, so the inner loop has no per-element bookkeeping:
+ *
+ *   for (interrupt_blocks block(n); block.next(); ) {
+ *     for (std::size_t i=block.begin(); i<block.end(); ++i) {
+ *       ...
+ *     }
+ *   }
+ *
+ * The block size is taken from the "bignum.interrupt_block_size" option
+ * (default: 8192).
+ *
+ * R must only be called from the main thread, so interrupts are only polled
+ * there. Loops running on worker threads never poll; the main thread is
+ * responsible for checking while it waits for them.
+ */
+
+// Is the calling thread the one that loaded the package?
+bool is_main_thread();
+
+// Checks for a user interrupt (main thread only).
+void check_interrupt();
+
+// Current block size. Refreshed from the option when called on the main
+// thread, otherwise the last value seen there is used.
+std::size_t interrupt_block_size();
+
+class interrupt_blocks {
+public:
+  explicit interrupt_blocks(std::size_t size, std::size_t start = 0)
+    : size(size), first(start), last(start), block_size(interrupt_block_size()) {}
+
+  // Moves to the next block, checking for interrupts first.
+  // Returns false once all elements have been visited.
+  bool next() {
+    if (last >= size) {
+      return false;
+    }
+
+    check_interrupt();
+    first = last;
+    last = first + std::min(block_size, size - first);
+    return true;
+  }
+
+  std::size_t begin() const { return first; }
+  std::size_t end() const { return last; }
+
+private:
+  std::size_t size;
+  std::size_t first;
+  std::size_t last;
+  std::size_t block_size;
+};
+
+#endif
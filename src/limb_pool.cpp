@@ -0,0 +1,98 @@
+#include <new>
+#include <vector>
+#include "limb_pool.h"
+
+namespace {
+
+// Size classes of 64 bytes to 1 MB
+const unsigned min_class_shift = 6;
+const unsigned n_classes = 15;
+// Free blocks kept per class, at most
+const std::size_t max_cached_bytes = 4 << 20;
+
+std::size_t class_bytes(unsigned c) {
+  return std::size_t(1) << (min_class_shift + c);
+}
+
+// Size class for `bytes`, or n_classes if too large to pool
+unsigned size_class(std::size_t bytes) {
+  std::size_t n = (bytes - 1) >> min_class_shift;
+  unsigned c = 0;
+  for (; n != 0 && c < n_classes; n >>= 1) {
+    ++c;
+  }
+  return c;
+}
+
+class pool {
+public:
+  ~pool();
+
+  void* allocate(unsigned c) {
+    if (free_blocks[c].empty()) {
+      return ::operator new(class_bytes(c));
+    }
+
+    void *block = free_blocks[c].back();
+    free_blocks[c].pop_back();
+    return block;
+  }
+
+  void deallocate(void *block, unsigned c) {
+    if ((free_blocks[c].size() + 1) * class_bytes(c) > max_cached_bytes) {
+      ::operator delete(block);
+    } else {
+      free_blocks[c].push_back(block);
+    }
+  }
+
+private:
+  std::vector<void*> free_blocks[n_classes];
+};
+
+// This thread's pool: created on first use, and NULL again once destroyed
+// at thread exit (values with static storage can outlive it)
+thread_local pool *current = NULL;
+thread_local bool finished = false;
+
+pool::~pool() {
+  current = NULL;
+  finished = true;
+  for (unsigned c=0; c<n_classes; ++c) {
+    for (std::size_t k=0; k<free_blocks[c].size(); ++k) {
+      ::operator delete(free_blocks[c][k]);
+    }
+  }
+}
+
+pool* local_pool() {
+  if (current == NULL && !finished) {
+    static thread_local pool instance;
+    current = &instance;
+  }
+  return current;
+}
+
+}
+
+// Blocks of a size class are always full-sized, even without a pool (at
+// thread exit), since another thread's pool may hand them out again
+void* limb_pool::allocate(std::size_t bytes) {
+  const unsigned c = size_class(bytes);
+  if (c == n_classes) {
+    return ::operator new(bytes);
+  }
+
+  pool *p = local_pool();
+  return p == NULL ? ::operator new(class_bytes(c)) : p->allocate(c);
+}
+
+void limb_pool::deallocate(void *block, std::size_t bytes) {
+  const unsigned c = size_class(bytes);
+  pool *p = c < n_classes ? local_pool() : NULL;
+  if (p == NULL) {
+    ::operator delete(block);
+  } else {
+    p->deallocate(block, c);
+  }
+}
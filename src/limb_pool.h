@@ -0,0 +1,58 @@
+#ifndef __BIGNUM_LIMB_POOL__
+#define __BIGNUM_LIMB_POOL__
+
+#include <cstddef>
+
+/*
+ * Recycles the limb storage of biginteger values.
+ *
+ * Kernels create and destroy many short-lived values of similar size (the
+ * result of each element, and the temporaries inside parsing, formatting
+ * and arithmetic), so freed blocks are kept in per-thread free lists, one
+ * per power-of-two size class, and handed out again by the next request of
+ * that class. Large blocks, and blocks beyond a per-class cap, go straight
+ * to the system allocator.
+ *
+ * Each thread has its own pool, so no locking is needed. A block freed by
+ * another thread than the one that allocated it simply joins the free
+ * lists of the thread freeing it.
+ */
+namespace limb_pool {
+
+void* allocate(std::size_t bytes);
+void deallocate(void *block, std::size_t bytes);
+
+}
+
+// Allocator for boost::multiprecision::cpp_int_backend
+template<class T>
+class pool_allocator {
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template<class U> struct rebind { typedef pool_allocator<U> other; };
+
+  pool_allocator() {}
+  template<class U> pool_allocator(const pool_allocator<U>&) {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(limb_pool::allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T *p, std::size_t n) {
+    limb_pool::deallocate(p, n * sizeof(T));
+  }
+};
+
+template<class T, class U>
+bool operator==(const pool_allocator<T>&, const pool_allocator<U>&) { return true; }
+template<class T, class U>
+bool operator!=(const pool_allocator<T>&, const pool_allocator<U>&) { return false; }
+
+#endif
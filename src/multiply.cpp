@@ -0,0 +1,455 @@
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include <vector>
+#include <boost/cstdint.hpp>
+#ifdef BIGNUM_USE_GMP
+#include <gmp.h>
+#endif
+#include "multiply.h"
+#include "fixed_width.h"
+
+namespace mp = boost::multiprecision;
+
+typedef boost::uint32_t digit_type;
+typedef boost::uint64_t wide_type;
+typedef std::vector<digit_type> digits_type;
+
+/*
+ * NTT multiplication
+ *
+ * Magnitudes are split into 32-bit digits, which are the coefficients of
+ * two polynomials. Their product is computed modulo three primes of the
+ * form k * 2^m + 1 (below 2^31), whose product exceeds every coefficient
+ * of the result (at most 2^23 * 2^64), so the coefficients are recovered
+ * exactly. Carries are propagated while recombining them.
+ */
+
+struct ntt_prime {
+  digit_type modulus;
+  digit_type root; // primitive root
+};
+
+static const ntt_prime ntt_primes[3] = {
+  {2013265921u, 31}, // 15 * 2^27 + 1
+  {469762049u, 3},   //  7 * 2^26 + 1
+  {754974721u, 11}   // 45 * 2^24 + 1
+};
+
+// Longest transform supported by every prime
+static const std::size_t ntt_max_length = std::size_t(1) << 24;
+
+
+/*-----------------------*
+ *  Modular arithmetic   *
+ *-----------------------*/
+static digit_type add_mod(digit_type a, digit_type b, digit_type p) {
+  const digit_type s = a + b;
+  return s >= p ? s - p : s;
+}
+
+static digit_type subtract_mod(digit_type a, digit_type b, digit_type p) {
+  return a >= b ? a - b : a + p - b;
+}
+
+static digit_type multiply_mod(digit_type a, digit_type b, digit_type p) {
+  return static_cast<digit_type>(static_cast<wide_type>(a) * b % p);
+}
+
+static digit_type pow_mod(digit_type a, wide_type n, digit_type p) {
+  digit_type output = 1;
+  for (; n != 0; n >>= 1) {
+    if (n & 1) {
+      output = multiply_mod(output, a, p);
+    }
+    a = multiply_mod(a, a, p);
+  }
+  return output;
+}
+
+static digit_type inverse_mod(digit_type a, digit_type p) {
+  return pow_mod(a, p - 2, p);
+}
+
+// Multiplication by a constant `w`, with `w_shoup = floor(w * 2^32 / p)`
+// precomputed, avoids the division
+static digit_type multiply_shoup(digit_type a, digit_type w, digit_type w_shoup, digit_type p) {
+  const digit_type q = static_cast<digit_type>((static_cast<wide_type>(a) * w_shoup) >> 32);
+  const digit_type r = a * w - q * p; // in [0, 2p)
+  return r >= p ? r - p : r;
+}
+
+
+/*--------------*
+ *  Transforms  *
+ *--------------*/
+// Powers of the roots of unity used by each butterfly level: entry
+// `len + j` is w^j, where w is a primitive (2 * len)-th root
+class ntt_roots {
+public:
+  digits_type value, shoup;
+
+  ntt_roots(std::size_t n, digit_type p, digit_type root) : value(n), shoup(n) {
+    for (std::size_t len=1; len<n; len <<= 1) {
+      const digit_type w = pow_mod(root, (p - 1) / (2 * len), p);
+      digit_type x = 1;
+      for (std::size_t j=0; j<len; ++j) {
+        value[len + j] = x;
+        shoup[len + j] = static_cast<digit_type>((static_cast<wide_type>(x) << 32) / p);
+        x = multiply_mod(x, w, p);
+      }
+    }
+  }
+};
+
+// Decimation in frequency: natural order in, bit-reversed order out
+static void forward_transform(digits_type &a, const ntt_roots &roots, digit_type p) {
+  const std::size_t n = a.size();
+  for (std::size_t len=n / 2; len>=1; len >>= 1) {
+    for (std::size_t i=0; i<n; i += 2 * len) {
+      for (std::size_t j=0; j<len; ++j) {
+        const digit_type u = a[i + j], v = a[i + j + len];
+        a[i + j] = add_mod(u, v, p);
+        a[i + j + len] = multiply_shoup(subtract_mod(u, v, p), roots.value[len + j], roots.shoup[len + j], p);
+      }
+    }
+  }
+}
+
+// Decimation in time with inverse roots: bit-reversed order in, natural
+// order out (not scaled by 1/n)
+static void inverse_transform(digits_type &a, const ntt_roots &roots, digit_type p) {
+  const std::size_t n = a.size();
+  for (std::size_t len=1; len<n; len <<= 1) {
+    for (std::size_t i=0; i<n; i += 2 * len) {
+      for (std::size_t j=0; j<len; ++j) {
+        const digit_type u = a[i + j];
+        const digit_type v = multiply_shoup(a[i + j + len], roots.value[len + j], roots.shoup[len + j], p);
+        a[i + j] = add_mod(u, v, p);
+        a[i + j + len] = subtract_mod(u, v, p);
+      }
+    }
+  }
+}
+
+// Cyclic convolution of `x` and `y` modulo `prime`, with length `n`
+static digits_type convolution(const digits_type &x, const digits_type &y, std::size_t n, const ntt_prime &prime) {
+  const digit_type p = prime.modulus;
+  const bool square = &x == &y;
+
+  digits_type a(n, 0);
+  for (std::size_t i=0; i<x.size(); ++i) {
+    a[i] = x[i] % p;
+  }
+
+  {
+    const ntt_roots roots(n, p, prime.root);
+    forward_transform(a, roots, p);
+
+    if (square) {
+      for (std::size_t i=0; i<n; ++i) {
+        a[i] = multiply_mod(a[i], a[i], p);
+      }
+    } else {
+      digits_type b(n, 0);
+      for (std::size_t i=0; i<y.size(); ++i) {
+        b[i] = y[i] % p;
+      }
+      forward_transform(b, roots, p);
+
+      for (std::size_t i=0; i<n; ++i) {
+        a[i] = multiply_mod(a[i], b[i], p);
+      }
+    }
+  }
+
+  inverse_transform(a, ntt_roots(n, p, inverse_mod(prime.root, p)), p);
+
+  const digit_type n_inverse = inverse_mod(static_cast<digit_type>(n % p), p);
+  const digit_type n_inverse_shoup = static_cast<digit_type>((static_cast<wide_type>(n_inverse) << 32) / p);
+  for (std::size_t i=0; i<n; ++i) {
+    a[i] = multiply_shoup(a[i], n_inverse, n_inverse_shoup, p);
+  }
+  return a;
+}
+
+// Digits of the product, from residues of its coefficients (Garner's
+// algorithm), propagating carries
+static digits_type recombine(const digits_type r[3], std::size_t n_digits) {
+  const digit_type p1 = ntt_primes[0].modulus;
+  const digit_type p2 = ntt_primes[1].modulus;
+  const digit_type p3 = ntt_primes[2].modulus;
+  const digit_type p1_inverse_p2 = inverse_mod(p1 % p2, p2);
+  const digit_type p1_inverse_p3 = inverse_mod(p1 % p3, p3);
+  const digit_type p2_inverse_p3 = inverse_mod(p2 % p3, p3);
+  const wide_type low_mask = 0xFFFFFFFFu;
+
+  digits_type output(n_digits);
+  wide_type carry = 0;
+
+  for (std::size_t k=0; k<n_digits; ++k) {
+    if (k < r[0].size()) {
+      // coefficient = v1 + p1 * (v2 + p2 * v3)
+      const digit_type v1 = r[0][k];
+      const digit_type v2 = multiply_mod(subtract_mod(r[1][k], v1 % p2, p2), p1_inverse_p2, p2);
+      const digit_type v3 = multiply_mod(
+        subtract_mod(multiply_mod(subtract_mod(r[2][k], v1 % p3, p3), p1_inverse_p3, p3), v2 % p3, p3),
+        p2_inverse_p3, p3
+      );
+      const wide_type t = v2 + static_cast<wide_type>(p2) * v3;
+
+      // coefficient = low + high * 2^32
+      const wide_type low = v1 + static_cast<wide_type>(p1) * (t & low_mask);
+      const wide_type high = static_cast<wide_type>(p1) * (t >> 32);
+      const wide_type sum = (low & low_mask) + (carry & low_mask);
+
+      output[k] = static_cast<digit_type>(sum);
+      carry = (low >> 32) + (carry >> 32) + (sum >> 32) + high;
+    } else {
+      output[k] = static_cast<digit_type>(carry);
+      carry >>= 32;
+    }
+  }
+
+  return output;
+}
+
+
+/*---------------*
+ *  Conversions  *
+ *---------------*/
+static const std::size_t limb_bits = sizeof(mp::limb_type) * CHAR_BIT;
+static const std::size_t digits_per_limb = limb_bits / 32;
+
+static digits_type to_digits(const biginteger_type &x) {
+  const mp::limb_type *limbs = x.backend().limbs();
+  digits_type output(x.backend().size() * digits_per_limb);
+
+  for (std::size_t k=0; k<output.size(); ++k) {
+    output[k] = static_cast<digit_type>(limbs[k / digits_per_limb] >> (32 * (k % digits_per_limb)));
+  }
+  while (!output.empty() && output.back() == 0) {
+    output.pop_back();
+  }
+  return output;
+}
+
+static biginteger_type from_digits(const digits_type &x, bool negative) {
+  const std::size_t n_limbs = std::max<std::size_t>((x.size() + digits_per_limb - 1) / digits_per_limb, 1);
+
+  biginteger_type output;
+  output.backend().resize(n_limbs, n_limbs);
+  mp::limb_type *limbs = output.backend().limbs();
+  std::fill(limbs, limbs + n_limbs, 0);
+
+  for (std::size_t k=0; k<x.size(); ++k) {
+    limbs[k / digits_per_limb] |= static_cast<mp::limb_type>(x[k]) << (32 * (k % digits_per_limb));
+  }
+  output.backend().normalize();
+  output.backend().sign(negative);
+  return output;
+}
+
+static biginteger_type ntt_multiply(const biginteger_type &x, const biginteger_type &y) {
+  // Squaring transforms a single operand
+  const digits_type a = to_digits(x);
+  const digits_type b = &x == &y ? digits_type() : to_digits(y);
+  const digits_type &b_ref = &x == &y ? a : b;
+
+  const std::size_t n_digits = a.size() + b_ref.size();
+  std::size_t n = 1;
+  while (n < n_digits) {
+    n <<= 1;
+  }
+
+  digits_type residues[3];
+  for (int k=0; k<3; ++k) {
+    residues[k] = convolution(a, b_ref, n, ntt_primes[k]);
+    residues[k].resize(n_digits - 1);
+  }
+
+  return from_digits(recombine(residues, n_digits), x.backend().sign() != y.backend().sign());
+}
+
+
+
+/*-------------------*
+ *  GMP (optional)   *
+ *-------------------*/
+#ifdef BIGNUM_USE_GMP
+// Owns an mpz_t, copied from or to the limbs of a biginteger
+class gmp_integer {
+public:
+  mpz_t value;
+
+  gmp_integer() { mpz_init(value); }
+  explicit gmp_integer(const biginteger_type &x) {
+    mpz_init(value);
+    mpz_import(value, x.backend().size(), -1, sizeof(mp::limb_type), 0, 0, x.backend().limbs());
+    if (x.backend().sign()) {
+      mpz_neg(value, value);
+    }
+  }
+  ~gmp_integer() { mpz_clear(value); }
+
+  biginteger_type to_biginteger() const {
+    const std::size_t n_limbs = std::max<std::size_t>((mpz_sizeinbase(value, 2) + limb_bits - 1) / limb_bits, 1);
+
+    biginteger_type output;
+    output.backend().resize(n_limbs, n_limbs);
+    std::fill(output.backend().limbs(), output.backend().limbs() + n_limbs, 0);
+    mpz_export(output.backend().limbs(), NULL, -1, sizeof(mp::limb_type), 0, 0, value);
+    output.backend().normalize();
+    output.backend().sign(mpz_sgn(value) < 0);
+    return output;
+  }
+
+private:
+  gmp_integer(const gmp_integer&);
+  gmp_integer& operator=(const gmp_integer&);
+};
+#endif
+
+biginteger_type fast_multiply(const biginteger_type &x, const biginteger_type &y) {
+  const std::size_t x_bits = bit_width(x), y_bits = bit_width(y);
+
+#ifdef BIGNUM_USE_GMP
+  if (std::min(x_bits, y_bits) >= gmp_threshold_bits) {
+    gmp_integer output;
+    mpz_mul(output.value, gmp_integer(x).value, gmp_integer(y).value);
+    return output.to_biginteger();
+  }
+#endif
+
+  const std::size_t n_digits = (x_bits + y_bits) / 32 + 2;
+
+  if (std::min(x_bits, y_bits) < ntt_threshold_bits || n_digits > ntt_max_length) {
+    return x * y;
+  }
+  return ntt_multiply(x, y);
+}
+
+biginteger_type fast_pow(const biginteger_type &x, unsigned n) {
+  if (n == 0) {
+    return 1;
+  }
+
+#ifdef BIGNUM_USE_GMP
+  if (bit_width(x) * n >= gmp_threshold_bits) {
+    gmp_integer output;
+    mpz_pow_ui(output.value, gmp_integer(x).value, n);
+    return output.to_biginteger();
+  }
+#endif
+
+  unsigned bit = 1;
+  while (bit <= n / 2) {
+    bit <<= 1;
+  }
+
+  biginteger_type output = x;
+  for (bit >>= 1; bit != 0; bit >>= 1) {
+    output = fast_multiply(output, output);
+    if (n & bit) {
+      output = fast_multiply(output, x);
+    }
+  }
+  return output;
+}
+
+
+/*-------------------*
+ *  Newton division  *
+ *-------------------*/
+// floor(2^(2n) / b), where b has exactly n bits
+static biginteger_type reciprocal(const biginteger_type &b, std::size_t n) {
+  if (n <= newton_threshold_bits) {
+    biginteger_type numerator = 1;
+    numerator <<= 2 * n;
+    return numerator / b;
+  }
+
+  // Approximation from the leading h bits, with one Newton step:
+  // x' = x + x * (2^(2n) - b * x) / 2^(2n)
+  const std::size_t h = n / 2 + 1;
+  const biginteger_type approximation = reciprocal(biginteger_type(b >> (n - h)), h) << (n - h);
+
+  biginteger_type one = 1;
+  one <<= 2 * n;
+  const biginteger_type error = one - fast_multiply(b, approximation);
+  const biginteger_type correction = fast_multiply(approximation, error < 0 ? biginteger_type(-error) : error) >> (2 * n);
+  biginteger_type output = error < 0 ? biginteger_type(approximation - correction) : biginteger_type(approximation + correction);
+
+  // A few units from the result
+  biginteger_type remainder = one - fast_multiply(b, output);
+  while (remainder < 0) {
+    --output;
+    remainder += b;
+  }
+  while (remainder >= b) {
+    ++output;
+    remainder -= b;
+  }
+  return output;
+}
+
+// Non-negative a and b, with b wider than newton_threshold_bits
+static void newton_divide(const biginteger_type &a, const biginteger_type &b, biginteger_type &quotient, biginteger_type &remainder) {
+  const std::size_t a_bits = bit_width(a), b_bits = bit_width(b);
+
+  // Scale the divisor so the reciprocal has at least half the bits of `a`
+  const std::size_t shift = a_bits > 2 * b_bits ? a_bits - 2 * b_bits : 0;
+  const std::size_t n = b_bits + shift;
+  const biginteger_type r = reciprocal(biginteger_type(b << shift), n);
+
+  // Underestimates the quotient by at most 2
+  quotient = fast_multiply(biginteger_type(a << shift), r) >> (2 * n);
+  remainder = a - fast_multiply(quotient, b);
+  while (remainder >= b) {
+    ++quotient;
+    remainder -= b;
+  }
+}
+
+void fast_divide(const biginteger_type &x, const biginteger_type &y, biginteger_type &quotient, biginteger_type &remainder) {
+  const std::size_t x_bits = bit_width(x), y_bits = bit_width(y);
+
+#ifdef BIGNUM_USE_GMP
+  // Truncated division, like the backend (y is not zero)
+  if (y_bits >= gmp_threshold_bits && x_bits >= y_bits) {
+    gmp_integer q, r;
+    mpz_tdiv_qr(q.value, r.value, gmp_integer(x).value, gmp_integer(y).value);
+    quotient = q.to_biginteger();
+    remainder = r.to_biginteger();
+    return;
+  }
+#endif
+
+  if (y_bits <= newton_threshold_bits || x_bits < y_bits + newton_threshold_bits) {
+    mp::divide_qr(x, y, quotient, remainder);
+    return;
+  }
+
+  const bool x_negative = x.backend().sign(), y_negative = y.backend().sign();
+  newton_divide(x_negative ? biginteger_type(-x) : x, y_negative ? biginteger_type(-y) : y, quotient, remainder);
+
+  // Truncated division: the remainder has the sign of the dividend
+  if (x_negative != y_negative) {
+    quotient = -quotient;
+  }
+  if (x_negative) {
+    remainder = -remainder;
+  }
+}
+
+biginteger_type fast_quotient(const biginteger_type &x, const biginteger_type &y) {
+  biginteger_type quotient, remainder;
+  fast_divide(x, y, quotient, remainder);
+  return quotient;
+}
+
+biginteger_type fast_remainder(const biginteger_type &x, const biginteger_type &y) {
+  biginteger_type quotient, remainder;
+  fast_divide(x, y, quotient, remainder);
+  return remainder;
+}
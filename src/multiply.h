@@ -0,0 +1,45 @@
+#ifndef __BIGNUM_MULTIPLY__
+#define __BIGNUM_MULTIPLY__
+
+#include <cstddef>
+#include "biginteger_vector.h"
+
+/*
+ * Multiplication and division of very large biginteger values.
+ *
+ * The backend multiplies with the schoolbook method, switching to Karatsuba
+ * above a few dozen limbs. Beyond `ntt_threshold_bits` (both operands), the
+ * product is computed by number-theoretic transforms (NTT) modulo three
+ * word-sized primes, recombined with the Chinese remainder theorem, which
+ * is O(n log n).
+ *
+ * Division uses the backend's long division, unless both the divisor and
+ * the quotient are longer than `newton_threshold_bits`. Then the reciprocal
+ * of the divisor is computed by Newton iteration, so dividing costs a few
+ * multiplications.
+ *
+ * When the package is built with GMP (BIGNUM_USE_GMP, see `configure`),
+ * operands above `gmp_threshold_bits` are copied to GMP instead, which is
+ * faster at these sizes.
+ *
+ * The thresholds were tuned with the multiplication and division benchmarks
+ * in bench/cpp.
+ */
+
+const std::size_t ntt_threshold_bits = 1 << 19;
+const std::size_t newton_threshold_bits = 1 << 15;
+#ifdef BIGNUM_USE_GMP
+const std::size_t gmp_threshold_bits = 1 << 10;
+#endif
+
+biginteger_type fast_multiply(const biginteger_type &x, const biginteger_type &y);
+
+// Truncated division (like `/` and `%`). Throws on division by zero.
+void fast_divide(const biginteger_type &x, const biginteger_type &y, biginteger_type &quotient, biginteger_type &remainder);
+biginteger_type fast_quotient(const biginteger_type &x, const biginteger_type &y);
+biginteger_type fast_remainder(const biginteger_type &x, const biginteger_type &y);
+
+// x^n by repeated squaring (n >= 0)
+biginteger_type fast_pow(const biginteger_type &x, unsigned n);
+
+#endif
@@ -1,22 +1,70 @@
+#ifndef __BIGNUM_OPERATIONS__
+#define __BIGNUM_OPERATIONS__
+
 #include <cpp11.hpp>
+#include "interrupt.h"
+
+/*
+ * Kernels read their inputs through element_reader, so they work with any
+ * storage layout. By default, elements are read from `data`. Other layouts
+ * (e.g. biginteger_arena) specialize element_reader, and kernel_result to
+ * name the vector type that holds their results.
+ */
+template<class Vec>
+class element_reader {
+  const Vec &x;
+
+public:
+  explicit element_reader(const Vec &x) : x(x) {}
+  auto operator()(std::size_t i) const -> decltype(x.data[i]) { return x.data[i]; }
+};
+
+template<class Vec>
+struct kernel_result {
+  typedef Vec type;
+};
+
+template<class Vec, class Func>
+typename kernel_result<Vec>::type unary_operation(const Vec &x, const Func &UnaryOperation) {
+  typename kernel_result<Vec>::type output(x.size());
+  element_reader<Vec> read(x);
+
+  for (interrupt_blocks block(x.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (x.is_na[i]) {
+        output.is_na[i] = true;
+      } else {
+        try {
+          output.data[i] = UnaryOperation(read(i));
+        } catch (...) {
+          output.is_na[i] = true; // # nocov
+        }
+      }
+    }
+  }
 
+  return output;
+}
 
 template<class Vec, class Func>
-Vec unary_operation(const Vec &x, const Func &UnaryOperation) {
-  Vec output(x.size());
+typename kernel_result<Vec>::type binary_operation(const Vec &lhs, const Vec &rhs, const Func &BinaryOperation) {
+  if (lhs.size() != rhs.size()) {
+    cpp11::stop("Incompatible sizes"); // # nocov
+  }
 
-  for (std::size_t i=0; i<x.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
+  typename kernel_result<Vec>::type output(lhs.size());
+  element_reader<Vec> read_lhs(lhs), read_rhs(rhs);
 
-    if (x.is_na[i]) {
-      output.is_na[i] = true;
-    } else {
-      try {
-        output.data[i] = UnaryOperation(x.data[i]);
-      } catch (...) {
-        output.is_na[i] = true; // # nocov
+  for (interrupt_blocks block(lhs.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (lhs.is_na[i] || rhs.is_na[i]) {
+        output.is_na[i] = true;
+      } else {
+        try {
+          output.data[i] = BinaryOperation(read_lhs(i), read_rhs(i));
+        } catch (...) {
+          output.is_na[i] = true; // # nocov
+        }
       }
     }
   }
@@ -24,26 +72,27 @@ Vec unary_operation(const Vec &x, const Func &UnaryOperation) {
   return output;
 }
 
+// Like binary_operation(), but the operation writes into the result element,
+// e.g. `out = x * y`, rather than returning a temporary
 template<class Vec, class Func>
-Vec binary_operation(const Vec &lhs, const Vec &rhs, const Func &BinaryOperation) {
+typename kernel_result<Vec>::type binary_operation_in_place(const Vec &lhs, const Vec &rhs, const Func &BinaryOperation) {
   if (lhs.size() != rhs.size()) {
     cpp11::stop("Incompatible sizes"); // # nocov
   }
 
-  Vec output(lhs.size());
+  typename kernel_result<Vec>::type output(lhs.size());
+  element_reader<Vec> read_lhs(lhs), read_rhs(rhs);
 
-  for (std::size_t i=0; i<lhs.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
-
-    if (lhs.is_na[i] || rhs.is_na[i]) {
-      output.is_na[i] = true;
-    } else {
-      try {
-        output.data[i] = BinaryOperation(lhs.data[i], rhs.data[i]);
-      } catch (...) {
-        output.is_na[i] = true; // # nocov
+  for (interrupt_blocks block(lhs.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (lhs.is_na[i] || rhs.is_na[i]) {
+        output.is_na[i] = true;
+      } else {
+        try {
+          BinaryOperation(output.data[i], read_lhs(i), read_rhs(i));
+        } catch (...) {
+          output.is_na[i] = true;
+        }
       }
     }
   }
@@ -52,25 +101,24 @@ Vec binary_operation(const Vec &lhs, const Vec &rhs, const Func &BinaryOperation
 }
 
 template<class Vec, class Func>
-Vec binary_operation(const Vec &lhs, const cpp11::integers &rhs, const Func &BinaryOperation) {
+typename kernel_result<Vec>::type binary_operation(const Vec &lhs, const cpp11::integers &rhs, const Func &BinaryOperation) {
   if (lhs.size() != static_cast<std::size_t>(rhs.size())) {
     cpp11::stop("Incompatible sizes"); // # nocov
   }
 
-  Vec output(lhs.size());
+  typename kernel_result<Vec>::type output(lhs.size());
+  element_reader<Vec> read_lhs(lhs);
 
-  for (std::size_t i=0; i<lhs.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
-
-    if (lhs.is_na[i] || rhs[i] == NA_INTEGER) {
-      output.is_na[i] = true;
-    } else {
-      try {
-        output.data[i] = BinaryOperation(lhs.data[i], rhs[i]);
-      } catch (...) {
-        output.is_na[i] = true; // # nocov
+  for (interrupt_blocks block(lhs.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (lhs.is_na[i] || rhs[i] == NA_INTEGER) {
+        output.is_na[i] = true;
+      } else {
+        try {
+          output.data[i] = BinaryOperation(read_lhs(i), rhs[i]);
+        } catch (...) {
+          output.is_na[i] = true; // # nocov
+        }
       }
     }
   }
@@ -79,31 +127,33 @@ Vec binary_operation(const Vec &lhs, const cpp11::integers &rhs, const Func &Bin
 }
 
 template<class Vec, class Func>
-Vec accumulate_operation(const Vec &x, const Vec &init, bool na_rm, const Func &BinaryOperation) {
+typename kernel_result<Vec>::type accumulate_operation(const Vec &x, const typename kernel_result<Vec>::type &init, bool na_rm, const Func &BinaryOperation) {
   if (init.size() != 1) {
     cpp11::stop("Initial value of C++ accumulate function must have 1 element"); // # nocov
   }
 
-  Vec output = init;
-
-  for (std::size_t i=0; i<x.size(); ++i) {
-    if (i % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
-
-    if (x.is_na[i] || std::isnan(static_cast<double>(x.data[i]))) {
-      if (na_rm) {
-        continue;
+  typename kernel_result<Vec>::type output = init;
+  element_reader<Vec> read(x);
+
+  bool done = false;
+  for (interrupt_blocks block(x.size()); !done && block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (x.is_na[i] || std::isnan(static_cast<double>(read(i)))) {
+        if (na_rm) {
+          continue;
+        } else {
+          output.is_na[0] = true;
+          done = true;
+          break;
+        }
       } else {
-        output.is_na[0] = true;
-        break;
-      }
-    } else {
-      try {
-        output.data[0] = BinaryOperation(output.data[0], x.data[i]);
-      } catch (...) {
-        output.is_na[0] = true; // # nocov
-        break;
+        try {
+          output.data[0] = BinaryOperation(output.data[0], read(i));
+        } catch (...) {
+          output.is_na[0] = true; // # nocov
+          done = true;
+          break;
+        }
       }
     }
   }
@@ -112,29 +162,32 @@ Vec accumulate_operation(const Vec &x, const Vec &init, bool na_rm, const Func &
 }
 
 template<class Vec, class Func>
-Vec partial_accumulate_operation(const Vec &x, const Func &BinaryOperation) {
-  Vec output(x.size());
+typename kernel_result<Vec>::type partial_accumulate_operation(const Vec &x, const Func &BinaryOperation) {
+  typename kernel_result<Vec>::type output(x.size());
+  element_reader<Vec> read(x);
 
   // initialize first element
-  output.data[0] = x.data[0];
+  output.data[0] = read(0);
   output.is_na[0] = x.is_na[0];
 
-  for (std::size_t i=1; i<x.size(); ++i) {
-    if ((i-1) % 8192 == 0) {
-      cpp11::check_user_interrupt();
-    }
-
-    if (x.is_na[i] || std::isnan(static_cast<double>(x.data[i])) || output.is_na[i-1]) {
-      output.is_na[i] = true;
-    } else {
-      try {
-        output.data[i] = BinaryOperation(output.data[i-1], x.data[i]);
-      } catch (...) {
-        output.is_na[i] = true; // # nocov
-        break;
+  bool done = false;
+  for (interrupt_blocks block(x.size(), 1); !done && block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (x.is_na[i] || std::isnan(static_cast<double>(read(i))) || output.is_na[i-1]) {
+        output.is_na[i] = true;
+      } else {
+        try {
+          output.data[i] = BinaryOperation(output.data[i-1], read(i));
+        } catch (...) {
+          output.is_na[i] = true; // # nocov
+          done = true;
+          break;
+        }
       }
     }
   }
 
   return output;
 }
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef __BIGNUM_OPTIONS__
+#define __BIGNUM_OPTIONS__
+
+#include <cpp11.hpp>
+
+// Reads a package option, e.g. options(bignum.string_cache = FALSE).
+// Must only be called from the main thread.
+
+inline bool option_flag(const char *name, bool default_value) {
+  SEXP option = Rf_GetOption1(Rf_install(name));
+  if (option == R_NilValue) {
+    return default_value;
+  }
+  int value = Rf_asLogical(option);
+  return value == NA_LOGICAL ? default_value : value != FALSE;
+}
+
+inline int option_int(const char *name, int default_value) {
+  SEXP option = Rf_GetOption1(Rf_install(name));
+  if (option == R_NilValue) {
+    return default_value;
+  }
+  int value = Rf_asInteger(option);
+  return value == NA_INTEGER ? default_value : value;
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef __BIGNUM_PARALLEL__
+#define __BIGNUM_PARALLEL__
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "interrupt.h"
+#include "options.h"
+
+/*
+ * Runs an element loop on several threads. The elements are split into
+ * blocks of `block_size` elements, which the threads take in turn:
+ *
+ *   parallel_blocks(n, 64, [&](std::size_t begin, std::size_t end) {
+ *     for (std::size_t i=begin; i<end; ++i) {
+ *       ...
+ *     }
+ *   });
+ *
+ * The block size is the unit of load balancing, so expensive per-element
+ * kernels should use small blocks. It is independent of the interrupt block
+ * size: with several threads, the calling thread only waits and checks for
+ * user interrupts every `parallel_poll_interval`. On an interrupt, the
+ * workers finish their current block and stop. With a single thread, the
+ * blocks run on the calling thread with a check between blocks.
+ *
+ * `fn` runs on worker threads, so it must not call R. If it throws (e.g.
+ * std::bad_alloc), the other threads stop after their current block and the
+ * first exception is rethrown on the calling thread.
+ *
+ * The number of threads is taken from the "bignum.num_threads" option
+ * (default: 1, so examples and checks stay on one core unless users opt in).
+ */
+
+static const std::chrono::milliseconds parallel_poll_interval(50);
+
+// Number of threads to use (main thread only)
+inline std::size_t parallel_num_threads() {
+  int value = option_int("bignum.num_threads", 1);
+  return value < 1 ? 1 : value;
+}
+
+template<class Fn>
+void parallel_blocks(std::size_t size, std::size_t block_size, Fn fn) {
+  const std::size_t n_blocks = (size + block_size - 1) / block_size;
+  const std::size_t n_threads = std::min(parallel_num_threads(), n_blocks);
+
+  auto run_block = [&](std::size_t b) {
+    fn(b * block_size, std::min(size, (b + 1) * block_size));
+  };
+
+  if (n_threads <= 1) {
+    for (std::size_t b=0; b<n_blocks; ++b) {
+      check_interrupt();
+      run_block(b);
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> next_block(0);
+  std::atomic<bool> cancelled(false);
+  std::exception_ptr worker_error;
+  std::size_t n_running = n_threads;
+  std::mutex mutex;
+  std::condition_variable finished;
+
+  auto run_blocks = [&]() {
+    try {
+      for (std::size_t b = next_block++; b < n_blocks && !cancelled; b = next_block++) {
+        run_block(b);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!worker_error) {
+        worker_error = std::current_exception();
+      }
+      cancelled = true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    --n_running;
+    finished.notify_one();
+  };
+
+  std::vector<std::thread> workers;
+  try {
+    for (std::size_t t=0; t<n_threads; ++t) {
+      workers.emplace_back(run_blocks);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!finished.wait_for(lock, parallel_poll_interval, [&]() { return n_running == 0; })) {
+      lock.unlock();
+      check_interrupt();
+      lock.lock();
+    }
+  } catch (...) {
+    cancelled = true;
+    for (std::size_t t=0; t<workers.size(); ++t) {
+      workers[t].join();
+    }
+    throw;
+  }
+
+  for (std::size_t t=0; t<workers.size(); ++t) {
+    workers[t].join();
+  }
+
+  if (worker_error) {
+    std::rethrow_exception(worker_error);
+  }
+}
+
+#endif
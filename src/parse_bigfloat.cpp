@@ -0,0 +1,362 @@
+#include <algorithm>
+#include <climits>
+#include <limits>
+#include <string>
+#include <boost/cstdint.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include "bigfloat_vector.h"
+
+namespace mp = boost::multiprecision;
+
+/*
+ * Decimal (and hexadecimal) to bigfloat conversion, reading the characters in
+ * place and reporting invalid input by returning false.
+ *
+ * Accepted input: an optional sign, then
+ *   - "Inf", "Infinity" or "NaN" (any case),
+ *   - decimal digits with an optional point and exponent ("1.5e-3"),
+ *   - "0x" and hexadecimal digits with an optional point and binary
+ *     exponent ("0x1.8p3").
+ *
+ * Results are correctly rounded. Short inputs (up to 19 significant digits,
+ * with a small exponent) take a fast path: the digits and the power of ten
+ * are both exact, so a single multiplication or division rounds once. Other
+ * inputs are computed with exact integer arithmetic.
+ */
+
+typedef mp::cpp_int integer_type;
+
+static const int fast_max_digits = 19;
+// 10^k is exact while 5^k fits in the significand
+static const int fast_max_exponent = 72;
+// Beyond this, exact arithmetic gets too expensive
+static const long exact_max_size = 100000;
+
+
+/*-----------*
+ *  Helpers  *
+ *-----------*/
+static bool is_digit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+static int hex_value(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+static bool equals_ignore_case(const char *first, const char *last, const char *word) {
+  for (; first != last && *word != '\0'; ++first, ++word) {
+    if ((*first | 0x20) != *word) {
+      return false;
+    }
+  }
+  return first == last && *word == '\0';
+}
+
+static const bigfloat_type& exact_power_of_ten(int k) {
+  struct table {
+    table() {
+      values[0] = 1;
+      for (int i=1; i<=fast_max_exponent; ++i) {
+        values[i] = values[i - 1] * 10;
+      }
+    }
+    bigfloat_type values[fast_max_exponent + 1];
+  };
+
+  static const table powers;
+  return powers.values[k];
+}
+
+// Signed exponent after `p` (at least one digit), saturating when huge
+static bool parse_exponent(const char *&p, const char *last, long &exponent) {
+  bool negative = false;
+  if (p != last && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    ++p;
+  }
+  if (p == last || !is_digit(*p)) {
+    return false;
+  }
+
+  exponent = 0;
+  for (; p != last && is_digit(*p); ++p) {
+    if (exponent < LONG_MAX / 100) {
+      exponent = exponent * 10 + (*p - '0');
+    }
+  }
+  if (negative) {
+    exponent = -exponent;
+  }
+  return true;
+}
+
+// Digits in [first, last), skipping a decimal point
+static void accumulate_digits(const char *first, const char *last, integer_type &n) {
+  boost::uint64_t chunk = 0, scale = 1;
+  n = 0;
+
+  for (const char *p=first; p!=last; ++p) {
+    if (*p == '.') {
+      continue;
+    }
+    chunk = chunk * 10 + (*p - '0');
+    scale *= 10;
+    if (scale == 10000000000000000000ULL) {
+      n = n * scale + chunk;
+      chunk = 0;
+      scale = 1;
+    }
+  }
+  if (scale > 1) {
+    n = n * scale + chunk;
+  }
+}
+
+// x * 2^exponent
+static bigfloat_type scale_by_two(const bigfloat_type &x, long exponent) {
+  const long limit = INT_MAX / 2;
+  const long clamped = exponent > limit ? limit : (exponent < -limit ? -limit : exponent);
+  return mp::ldexp(x, static_cast<int>(clamped));
+}
+
+
+// n * 2^exponent, rounding to nearest (ties to even) once
+static bigfloat_type round_to_bigfloat(const integer_type &n, long exponent) {
+  const long digits = std::numeric_limits<bigfloat_type>::digits;
+  const long excess = static_cast<long>(mp::msb(n)) + 1 - digits;
+  if (excess <= 0) {
+    return scale_by_two(bigfloat_type(n), exponent);
+  }
+
+  integer_type significand = n >> excess;
+  const bool half = mp::bit_test(n, excess - 1);
+  const bool sticky = mp::lsb(n) < static_cast<unsigned>(excess - 1);
+  if (half && (sticky || mp::bit_test(significand, 0))) {
+    ++significand;
+  }
+  return scale_by_two(bigfloat_type(significand), exponent + excess);
+}
+
+
+/*------------------*
+ *  Decimal values  *
+ *------------------*/
+// n * 10^exponent, with exact integer arithmetic
+static bigfloat_type exact_decimal(const integer_type &n, long exponent) {
+  if (exponent >= 0) {
+    // n * 5^e is an exact integer
+    const integer_type scaled = n * mp::pow(integer_type(5), static_cast<unsigned>(exponent));
+    return round_to_bigfloat(scaled, exponent);
+  }
+
+  // n / 5^k: a quotient with a few more bits than the significand, plus a
+  // sticky bit for a non-zero remainder, rounds like the exact value
+  const long k = -exponent;
+  const integer_type divisor = mp::pow(integer_type(5), static_cast<unsigned>(k));
+  const long needed = std::numeric_limits<bigfloat_type>::digits + 2;
+  const long shift = std::max(0L, needed + static_cast<long>(mp::msb(divisor)) - static_cast<long>(mp::msb(n)));
+
+  integer_type quotient, remainder;
+  mp::divide_qr(integer_type(n << shift), divisor, quotient, remainder);
+  quotient <<= 1;
+  if (remainder != 0) {
+    quotient |= 1;
+  }
+
+  return round_to_bigfloat(quotient, exponent - shift - 1);
+}
+
+static bool parse_decimal(const char *first, const char *last, bigfloat_type &value) {
+  // Mantissa: digits with at most one point
+  const char *p = first;
+  const char *point = NULL;
+  long n_digits = 0;
+  for (; p != last; ++p) {
+    if (is_digit(*p)) {
+      ++n_digits;
+    } else if (*p == '.' && point == NULL) {
+      point = p;
+    } else {
+      break;
+    }
+  }
+  const char *mantissa_last = p;
+  if (n_digits == 0) {
+    return false;
+  }
+
+  long exponent = 0;
+  if (p != last && (*p == 'e' || *p == 'E')) {
+    ++p;
+    if (!parse_exponent(p, last, exponent)) {
+      return false;
+    }
+  }
+  if (p != last) {
+    return false;
+  }
+
+  // Significant digits, without leading and trailing zeros
+  const char *sig_first = first;
+  while (sig_first != mantissa_last && (*sig_first == '0' || *sig_first == '.')) {
+    ++sig_first;
+  }
+  if (sig_first == mantissa_last) {
+    value = 0;
+    return true;
+  }
+  const char *sig_last = mantissa_last;
+  while (*(sig_last - 1) == '0' || *(sig_last - 1) == '.') {
+    --sig_last;
+  }
+
+  // Scale so the significant digits are an integer
+  long n_significant = 0;
+  for (const char *q=sig_first; q!=sig_last; ++q) {
+    n_significant += *q != '.';
+  }
+  const char *units = point == NULL ? mantissa_last : point;
+  if (sig_last > units) {
+    exponent -= sig_last - units - 1;
+  } else {
+    exponent += units - sig_last;
+  }
+
+  if (n_significant <= fast_max_digits && exponent >= -fast_max_exponent && exponent <= fast_max_exponent) {
+    boost::uint64_t n = 0;
+    for (const char *q=sig_first; q!=sig_last; ++q) {
+      if (*q != '.') {
+        n = n * 10 + (*q - '0');
+      }
+    }
+
+    value = bigfloat_type(n);
+    if (exponent > 0) {
+      value *= exact_power_of_ten(exponent);
+    } else if (exponent < 0) {
+      value /= exact_power_of_ten(-exponent);
+    }
+    return true;
+  }
+
+  // Values far outside the exponent range overflow or underflow
+  const long magnitude = exponent + n_significant;
+  if (magnitude > std::numeric_limits<bigfloat_type>::max_exponent10 + 1) {
+    value = std::numeric_limits<bigfloat_type>::infinity();
+    return true;
+  }
+  if (magnitude < std::numeric_limits<bigfloat_type>::min_exponent10 - 1) {
+    value = 0;
+    return true;
+  }
+
+  if (n_significant <= exact_max_size && exponent >= -exact_max_size && exponent <= exact_max_size) {
+    integer_type n;
+    accumulate_digits(sig_first, sig_last, n);
+    value = exact_decimal(n, exponent);
+    return true;
+  }
+
+  // Rare: huge inputs use the general conversion (the input is valid)
+  try {
+    value = bigfloat_type(std::string(first, last));
+  } catch (...) {
+    return false; // # nocov
+  }
+  return true;
+}
+
+
+/*----------------------*
+ *  Hexadecimal values  *
+ *----------------------*/
+static bool parse_hex(const char *first, const char *last, bigfloat_type &value) {
+  integer_type n = 0;
+  boost::uint64_t small = 0;
+  bool is_small = true;
+  long exponent = 0;
+  bool any_digits = false, seen_point = false;
+
+  const char *p = first;
+  for (; p != last; ++p) {
+    if (*p == '.' && !seen_point) {
+      seen_point = true;
+      continue;
+    }
+    const int digit = hex_value(*p);
+    if (digit < 0) {
+      break;
+    }
+
+    any_digits = true;
+    if (is_small && (small >> 60) != 0) {
+      n = small;
+      is_small = false;
+    }
+    if (is_small) {
+      small = (small << 4) | digit;
+    } else {
+      n = (n << 4) | digit;
+    }
+    if (seen_point) {
+      exponent -= 4;
+    }
+  }
+  if (!any_digits) {
+    return false;
+  }
+
+  if (p != last && (*p == 'p' || *p == 'P')) {
+    ++p;
+    long binary_exponent;
+    if (!parse_exponent(p, last, binary_exponent)) {
+      return false;
+    }
+    exponent += binary_exponent;
+  }
+  if (p != last) {
+    return false;
+  }
+
+  value = is_small ? scale_by_two(bigfloat_type(small), exponent) : round_to_bigfloat(n, exponent);
+  return true;
+}
+
+
+/*---------------*
+ *  Entry point  *
+ *---------------*/
+bool parse_bigfloat(const char *first, const char *last, bigfloat_type &value) {
+  bool negative = false;
+  if (first != last && (*first == '+' || *first == '-')) {
+    negative = *first == '-';
+    ++first;
+  }
+  if (first == last) {
+    return false;
+  }
+
+  bool ok;
+  if (last - first > 2 && first[0] == '0' && (first[1] == 'x' || first[1] == 'X')) {
+    ok = parse_hex(first + 2, last, value);
+  } else if (is_digit(*first) || *first == '.') {
+    ok = parse_decimal(first, last, value);
+  } else if (equals_ignore_case(first, last, "inf") || equals_ignore_case(first, last, "infinity")) {
+    value = std::numeric_limits<bigfloat_type>::infinity();
+    ok = true;
+  } else if (equals_ignore_case(first, last, "nan")) {
+    value = std::numeric_limits<bigfloat_type>::quiet_NaN();
+    return true;
+  } else {
+    ok = false;
+  }
+
+  if (ok && negative && value != 0) {
+    value = -value;
+  }
+  return ok;
+}
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cstring>
+#include <cpp11.hpp>
+#include "biginteger_vector.h"
+#include "bigfloat_vector.h"
+#include "format.h"
+#include "interrupt.h"
+
+using namespace cpp11::literals;
+namespace mp = boost::multiprecision;
+
+
+/*
+ * Pieces used by pillar_shaft() to align a column in one notation: each
+ * number is split into lhs "." rhs "e" exp, while non-finite values are
+ * kept whole in `other`. Column widths are accumulated as elements are set.
+ */
+class decimal_layout {
+public:
+  explicit decimal_layout(std::size_t size)
+    : num(size), neg(size), lhs(size), dec(size), rhs(size), exp(size), other(size) {}
+
+  void set_number(std::size_t i, const std::string &mantissa, bool negative, int exponent) {
+    const std::size_t point = mantissa.find('.');
+    const bool has_point = point != std::string::npos;
+    const std::string left = mantissa.substr(0, point);
+    const std::string right = has_point ? mantissa.substr(point + 1) : "";
+
+    num[i] = TRUE;
+    neg[i] = negative ? TRUE : FALSE;
+    lhs[i] = left;
+    dec[i] = has_point ? TRUE : FALSE;
+    rhs[i] = right;
+    exp[i] = exponent;
+    other[i] = NA_STRING;
+
+    lhs_width = std::max(lhs_width, static_cast<int>(left.size()));
+    rhs_width = std::max(rhs_width, static_cast<int>(right.size()));
+    any_dec = any_dec || has_point;
+
+    if (exponent != NA_INTEGER) {
+      any_exp = true;
+      any_neg_exp = any_neg_exp || exponent < 0;
+      exp_digits = std::max(exp_digits, count_digits(std::abs(exponent)));
+    }
+  }
+
+  // Splits "<mantissa>e<exponent>", hiding the exponent of exact zero
+  void set_scientific(std::size_t i, const std::string &formatted, bool negative, bool is_zero) {
+    const std::size_t pos = formatted.find('e');
+    int exponent = NA_INTEGER;
+    if (!is_zero && pos != std::string::npos) {
+      exponent = std::atoi(formatted.c_str() + pos + 1);
+    }
+    set_number(i, formatted.substr(0, pos), negative, exponent);
+  }
+
+  // `label` is NULL for missing values
+  void set_other(std::size_t i, const char *label, bool negative) {
+    num[i] = FALSE;
+    neg[i] = negative ? TRUE : FALSE;
+    lhs[i] = "";
+    dec[i] = FALSE;
+    rhs[i] = "";
+    exp[i] = NA_INTEGER;
+
+    if (label == NULL) {
+      other[i] = NA_STRING;
+      other_width = std::max(other_width, 2);
+    } else {
+      other[i] = label;
+      other_width = std::max(other_width, static_cast<int>(std::strlen(label)));
+    }
+  }
+
+  cpp11::list result() {
+    const int dec_width = any_dec ? 1 : 0;
+    const int exp_width = any_exp ? any_neg_exp + 1 + exp_digits : 0;
+    const int total_width = std::max(lhs_width + dec_width + rhs_width + exp_width, other_width);
+
+    cpp11::writable::list output({
+      "num"_nm = num,
+      "neg"_nm = neg,
+      "lhs"_nm = lhs,
+      "dec"_nm = dec,
+      "rhs"_nm = rhs,
+      "exp"_nm = exp,
+      "other"_nm = other
+    });
+
+    output.attr("widths") = cpp11::writable::list({
+      "lhs"_nm = lhs_width,
+      "dec"_nm = dec_width,
+      "rhs"_nm = rhs_width,
+      "exp"_nm = exp_width,
+      "other"_nm = other_width,
+      "total"_nm = total_width
+    });
+    output.attr("width") = total_width;
+
+    return output;
+  }
+
+private:
+  static int count_digits(int x) {
+    int n = 1;
+    while (x >= 10) {
+      x /= 10;
+      ++n;
+    }
+    return n;
+  }
+
+  cpp11::writable::logicals num;
+  cpp11::writable::logicals neg;
+  cpp11::writable::strings lhs;
+  cpp11::writable::logicals dec;
+  cpp11::writable::strings rhs;
+  cpp11::writable::integers exp;
+  cpp11::writable::strings other;
+
+  int lhs_width = 0;
+  int rhs_width = 0;
+  int other_width = 0;
+  int exp_digits = 0;
+  bool any_dec = false;
+  bool any_exp = false;
+  bool any_neg_exp = false;
+};
+
+
+[[cpp11::register]]
+cpp11::list c_bigfloat_pillar_layout(cpp11::strings x, int sigfig) {
+  bigfloat_vector input(x);
+  decimal_layout dec(input.size());
+  decimal_layout sci(input.size());
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      const bigfloat_type &value = input.data[i];
+
+      if (input.is_na[i]) {
+        dec.set_other(i, NULL, false);
+        sci.set_other(i, NULL, false);
+      } else if (mp::isnan(value)) {
+        dec.set_other(i, "NaN", false);
+        sci.set_other(i, "NaN", false);
+      } else if (mp::isinf(value)) {
+        dec.set_other(i, value > 0 ? "Inf" : "-Inf", value < 0);
+        sci.set_other(i, value > 0 ? "Inf" : "-Inf", value < 0);
+      } else {
+        dec.set_number(i, format_bigfloat(value, bignum_format_dec, sigfig, true), value < 0, NA_INTEGER);
+        sci.set_scientific(i, format_bigfloat(value, bignum_format_sci, sigfig, true), value < 0, value == 0);
+      }
+    }
+  }
+
+  return cpp11::writable::list({"dec"_nm = dec.result(), "sci"_nm = sci.result()});
+}
+
+[[cpp11::register]]
+cpp11::list c_biginteger_pillar_layout(cpp11::strings x, int sigfig) {
+  biginteger_vector input(x);
+  decimal_layout dec(input.size());
+  decimal_layout sci(input.size());
+
+  for (interrupt_blocks block(input.size()); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      const biginteger_type &value = input.data[i];
+
+      if (input.is_na[i]) {
+        dec.set_other(i, NULL, false);
+        sci.set_other(i, NULL, false);
+      } else {
+        dec.set_number(i, value.str(), value < 0, NA_INTEGER);
+        sci.set_scientific(i, format_bigfloat(bigfloat_type(value), bignum_format_sci, sigfig, true), value < 0, value == 0);
+      }
+    }
+  }
+
+  return cpp11::writable::list({"dec"_nm = dec.result(), "sci"_nm = sci.result()});
+}
@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <random>
+#include <boost/multiprecision/integer.hpp>
+#include <boost/multiprecision/miller_rabin.hpp>
+#include "primes.h"
+
+namespace mp = boost::multiprecision;
+
+
+/*----------------------*
+ *  Small-prime table   *
+ *----------------------*/
+static const unsigned small_prime_limit = 1000;
+
+static std::vector<unsigned> sieve_small_primes() {
+  std::vector<bool> composite(small_prime_limit, false);
+  std::vector<unsigned> primes;
+
+  for (unsigned p=2; p<small_prime_limit; ++p) {
+    if (!composite[p]) {
+      primes.push_back(p);
+      for (unsigned k=p * p; k<small_prime_limit; k+=p) {
+        composite[k] = true;
+      }
+    }
+  }
+
+  return primes;
+}
+
+static const std::vector<unsigned>& small_primes() {
+  static const std::vector<unsigned> primes = sieve_small_primes();
+  return primes;
+}
+
+
+/*-------------------*
+ *  Primality test   *
+ *-------------------*/
+// One Miller-Rabin round, with n - 1 = q * 2^k (q odd)
+static bool miller_rabin_round(const biginteger_type &n, const biginteger_type &q, unsigned k, unsigned base) {
+  const biginteger_type n_minus_1 = n - 1;
+  biginteger_type y = mp::powm(biginteger_type(base), q, n);
+
+  if (y == 1 || y == n_minus_1) {
+    return true;
+  }
+  for (unsigned j=1; j<k; ++j) {
+    y = mp::powm(y, 2, n);
+    if (y == n_minus_1) {
+      return true;
+    }
+    if (y == 1) {
+      return false;
+    }
+  }
+  return false;
+}
+
+bool is_prime(const biginteger_type &x) {
+  if (x < 2) {
+    return false;
+  }
+
+  const std::vector<unsigned> &primes = small_primes();
+  for (std::size_t k=0; k<primes.size(); ++k) {
+    if (x == primes[k]) {
+      return true;
+    }
+    if (mp::integer_modulus(x, primes[k]) == 0) {
+      return false;
+    }
+  }
+  if (x < small_prime_limit * small_prime_limit) {
+    return true;
+  }
+
+  // The first 13 prime bases are deterministic below 3317044064679887385961981
+  static const unsigned bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41};
+  static const biginteger_type deterministic_limit("3317044064679887385961981");
+
+  biginteger_type q = x - 1;
+  const unsigned k = mp::lsb(q);
+  q >>= k;
+
+  for (std::size_t b=0; b<sizeof(bases) / sizeof(bases[0]); ++b) {
+    if (!miller_rabin_round(x, q, k, bases[b])) {
+      return false;
+    }
+  }
+  if (x < deterministic_limit) {
+    return true;
+  }
+
+  // Seeded per call, so results don't depend on the order of evaluation
+  std::mt19937 gen(5489u);
+  return mp::miller_rabin_test(x, 12, gen);
+}
+
+biginteger_type next_prime(const biginteger_type &x) {
+  if (x < 2) {
+    return 2;
+  }
+
+  biginteger_type candidate = mp::bit_test(x, 0) ? biginteger_type(x + 2) : biginteger_type(x + 1);
+  while (!is_prime(candidate)) {
+    candidate += 2;
+  }
+  return candidate;
+}
+
+
+/*-----------------*
+ *  Factorisation  *
+ *-----------------*/
+static biginteger_type abs_difference(const biginteger_type &x, const biginteger_type &y) {
+  return x < y ? biginteger_type(y - x) : biginteger_type(x - y);
+}
+
+// Iterations of the rho method allowed per element, which bounds the time
+// spent on values with two large prime factors
+static const std::size_t rho_iteration_limit = std::size_t(1) << 22;
+
+// A non-trivial divisor of the odd composite `n` (Brent's variant of rho), or
+// 0 if `iterations` reaches rho_iteration_limit first
+static biginteger_type pollard_brent(const biginteger_type &n, std::size_t &iterations) {
+  const std::size_t batch = 128;
+
+  for (unsigned c=1; ; ++c) {
+    biginteger_type x = 2, y = 2, ys, product = 1, divisor = 1;
+
+    for (std::size_t r=1; divisor == 1; r*=2) {
+      if (iterations + 2 * r > rho_iteration_limit) {
+        return 0;
+      }
+      iterations += 2 * r;
+
+      x = y;
+      for (std::size_t i=0; i<r; ++i) {
+        y = (y * y + c) % n;
+      }
+
+      for (std::size_t k=0; k<r && divisor == 1; k+=batch) {
+        ys = y;
+        for (std::size_t i=0; i<std::min(batch, r - k); ++i) {
+          y = (y * y + c) % n;
+          product = (product * abs_difference(x, y)) % n;
+        }
+        divisor = mp::gcd(product, n);
+      }
+    }
+
+    // The batched product hit a multiple of n, so retrace one step at a time
+    // (at most one batch)
+    if (divisor == n) {
+      do {
+        ys = (ys * ys + c) % n;
+        divisor = mp::gcd(abs_difference(x, ys), n);
+      } while (divisor == 1);
+    }
+
+    if (divisor != n) {
+      return divisor;
+    }
+  }
+}
+
+static bool factor_composite(const biginteger_type &n, std::vector<biginteger_type> &factors, std::size_t &iterations) {
+  if (is_prime(n)) {
+    factors.push_back(n);
+    return true;
+  }
+
+  const biginteger_type divisor = pollard_brent(n, iterations);
+  return divisor != 0 &&
+    factor_composite(divisor, factors, iterations) &&
+    factor_composite(n / divisor, factors, iterations);
+}
+
+bool prime_factors(const biginteger_type &x, std::vector<biginteger_type> &factors) {
+  factors.clear();
+  biginteger_type remainder = x < 0 ? biginteger_type(-x) : x;
+
+  const std::vector<unsigned> &primes = small_primes();
+  for (std::size_t k=0; k<primes.size() && remainder > 1; ++k) {
+    while (mp::integer_modulus(remainder, primes[k]) == 0) {
+      factors.push_back(primes[k]);
+      remainder /= primes[k];
+    }
+  }
+
+  std::size_t iterations = 0;
+  if (remainder > 1 && !factor_composite(remainder, factors, iterations)) {
+    factors.clear();
+    return false;
+  }
+
+  std::sort(factors.begin(), factors.end());
+  return true;
+}
@@ -0,0 +1,31 @@
+#ifndef __BIGNUM_PRIMES__
+#define __BIGNUM_PRIMES__
+
+#include <vector>
+#include "biginteger_vector.h"
+
+/*
+ * Primality testing and factorisation.
+ *
+ * Candidates are first divided by a table of small primes. Survivors are
+ * tested by Miller-Rabin with fixed bases, which is deterministic below
+ * 3.3e24. Larger candidates then also go through boost's Miller-Rabin test
+ * with a fixed seed, so they are probable primes (and results are
+ * reproducible).
+ *
+ * Factors beyond the small-prime table are found by Pollard's rho method
+ * (Brent's variant), whose cost grows with the square root of the second
+ * largest prime factor. The number of iterations is bounded, so values with
+ * two large prime factors aren't factorised.
+ */
+
+bool is_prime(const biginteger_type &x);
+
+// Smallest prime greater than `x`
+biginteger_type next_prime(const biginteger_type &x);
+
+// Prime factors of |x| in increasing order, with multiplicity (x != 0).
+// Returns false if they weren't found within the iteration limit.
+bool prime_factors(const biginteger_type &x, std::vector<biginteger_type> &factors);
+
+#endif
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <cpp11.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include "biginteger_vector.h"
+#include "bigfloat_vector.h"
+#include "interrupt.h"
+
+namespace ip = boost::interprocess;
+
+
+/*------------------------------------*
+ *  Column sinks (parse into backing)  *
+ *------------------------------------*/
+class column_sink {
+public:
+  virtual ~column_sink() {}
+  virtual void push(const char *first, const char *last) = 0;
+  virtual cpp11::strings encode() const = 0;
+};
+
+template<class Vec, class T, bool (*Parse)(const char*, const char*, T&)>
+class vector_sink : public column_sink {
+public:
+  void push(const char *first, const char *last) {
+    output.data.push_back(T());
+    output.is_na.push_back(!Parse(first, last, output.data.back()));
+  }
+
+  cpp11::strings encode() const {
+    return output.encode();
+  }
+
+private:
+  Vec output;
+};
+
+typedef vector_sink<biginteger_vector, biginteger_type, parse_biginteger> biginteger_sink;
+typedef vector_sink<bigfloat_vector, bigfloat_type, parse_bigfloat> bigfloat_sink;
+
+
+/*--------------------*
+ *  Field tokenising  *
+ *--------------------*/
+
+// Strips surrounding whitespace and quotes from a field. Fields containing
+// "NA" are treated as missing, which the parsers signal via an empty range.
+void trim_whitespace(const char *&first, const char *&last) {
+  while (first < last && (*first == ' ' || *first == '\t')) ++first;
+  while (last > first && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r')) --last;
+}
+
+void trim_field(const char *&first, const char *&last) {
+  trim_whitespace(first, last);
+
+  if (last - first >= 2 && *first == '"' && last[-1] == '"') {
+    ++first;
+    --last;
+    trim_whitespace(first, last);
+  }
+
+  if (last - first == 2 && first[0] == 'N' && first[1] == 'A') {
+    last = first;
+  }
+}
+
+// Returns the end of the field starting at `first` (quoted delimiters are
+// skipped).
+const char* field_end(const char *first, const char *last, char delim) {
+  bool quoted = false;
+  for (const char *p = first; p < last; ++p) {
+    if (*p == '"') {
+      quoted = !quoted;
+    } else if (*p == delim && !quoted) {
+      return p;
+    }
+  }
+  return last;
+}
+
+// Splits a line into fields, calling `on_field(index, first, last)`.
+template<class Func>
+void split_line(const char *first, const char *last, char delim, const Func &on_field) {
+  std::size_t index = 0;
+  const char *p = first;
+  while (true) {
+    const char *end = field_end(p, last, delim);
+    if (!on_field(index++, p, end) || end == last) {
+      break;
+    }
+    p = end + 1;
+  }
+}
+
+
+/*------------------------*
+ *  Memory-mapped reader  *
+ *------------------------*/
+class delim_reader {
+public:
+  delim_reader(const std::string &path, std::size_t chunk_size)
+    : path(path), chunk_size(chunk_size) {
+    std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+    if (!file) {
+      cpp11::stop("Can't open file '%s'.", path.c_str());
+    }
+    file_size = static_cast<std::size_t>(file.tellg());
+  }
+
+  // Calls `on_line(first, last)` for every line of the file (excluding the
+  // line terminator). The file is mapped one window at a time; a line that
+  // straddles two windows is re-read from the start of the next window.
+  template<class Func>
+  void for_each_line(const Func &on_line) const {
+    if (file_size == 0) {
+      return;
+    }
+
+    ip::file_mapping mapping(path.c_str(), ip::read_only);
+    const std::size_t page_size = ip::mapped_region::get_page_size();
+
+    std::size_t pos = 0;
+    std::size_t window = std::max(chunk_size, page_size);
+    bool stop = false;
+
+    while (pos < file_size && !stop) {
+      check_interrupt();
+
+      const std::size_t offset = pos - pos % page_size;
+      const std::size_t size = std::min(window, file_size - offset);
+      ip::mapped_region region(mapping, ip::read_only, offset, size);
+
+      const char *begin = static_cast<const char*>(region.get_address());
+      const char *end = begin + size;
+      const char *line = begin + (pos - offset);
+      const bool at_eof = offset + size == file_size;
+
+      std::size_t n_lines = 0;
+      while (line < end) {
+        const char *eol = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (eol == NULL) {
+          if (!at_eof) break;
+          eol = end;
+        }
+
+        ++n_lines;
+        if (!on_line(line, eol)) {
+          stop = true;
+          break;
+        }
+        line = eol + 1;
+      }
+
+      pos = std::min(static_cast<std::size_t>(line - begin) + offset, file_size);
+
+      // a single line is longer than the window
+      if (n_lines == 0 && !stop) {
+        window *= 2;
+      }
+    }
+  }
+
+private:
+  std::string path;
+  std::size_t chunk_size;
+  std::size_t file_size;
+};
+
+
+[[cpp11::register]]
+cpp11::strings c_read_delim_header(cpp11::strings path, cpp11::strings delim, int skip) {
+  delim_reader reader(path[0], 1 << 16);
+  const char sep = std::string(delim[0])[0];
+
+  cpp11::writable::strings output;
+  int line_number = 0;
+  reader.for_each_line([&](const char *first, const char *last) {
+    if (line_number++ < skip) {
+      return true;
+    }
+
+    split_line(first, last, sep, [&](std::size_t, const char *a, const char *b) {
+      trim_field(a, b);
+      output.push_back(std::string(a, b));
+      return true;
+    });
+    return false;
+  });
+
+  return output;
+}
+
+[[cpp11::register]]
+cpp11::list c_read_delim_bignum(cpp11::strings path,
+                                cpp11::integers cols,
+                                cpp11::strings types,
+                                cpp11::strings delim,
+                                int skip,
+                                double chunk_size) {
+  if (cols.size() != types.size()) {
+    cpp11::stop("`cols` and `types` must have the same size."); // # nocov
+  }
+
+  const std::size_t n_cols = cols.size();
+  std::vector<std::unique_ptr<column_sink> > sinks(n_cols);
+  for (std::size_t j=0; j<n_cols; ++j) {
+    const std::string type(types[j]);
+    if (type == "biginteger") {
+      sinks[j].reset(new biginteger_sink());
+    } else if (type == "bigfloat") {
+      sinks[j].reset(new bigfloat_sink());
+    } else {
+      cpp11::stop("Found unexpected column type."); // # nocov
+    }
+  }
+
+  // map file columns to output columns (-1 if not selected)
+  int max_col = 0;
+  for (std::size_t j=0; j<n_cols; ++j) {
+    max_col = std::max(max_col, cols[j]);
+  }
+  std::vector<int> selected(max_col, -1);
+  for (std::size_t j=0; j<n_cols; ++j) {
+    selected[cols[j] - 1] = j;
+  }
+
+  delim_reader reader(path[0], static_cast<std::size_t>(chunk_size));
+  const char sep = std::string(delim[0])[0];
+  std::vector<bool> seen(n_cols);
+
+  int line_number = 0;
+  reader.for_each_line([&](const char *first, const char *last) {
+    if (line_number++ < skip) {
+      return true;
+    }
+
+    // skip blank lines
+    if (first == last || (last - first == 1 && *first == '\r')) {
+      return true;
+    }
+
+    std::fill(seen.begin(), seen.end(), false);
+    split_line(first, last, sep, [&](std::size_t index, const char *a, const char *b) {
+      if (index >= selected.size()) {
+        return false;
+      }
+      if (selected[index] >= 0) {
+        trim_field(a, b);
+        sinks[selected[index]]->push(a, b);
+        seen[selected[index]] = true;
+      }
+      return true;
+    });
+
+    // missing trailing fields
+    for (std::size_t j=0; j<n_cols; ++j) {
+      if (!seen[j]) {
+        sinks[j]->push(first, first);
+      }
+    }
+
+    return true;
+  });
+
+  cpp11::writable::list output(n_cols);
+  for (std::size_t j=0; j<n_cols; ++j) {
+    output[j] = sinks[j]->encode();
+  }
+
+  return output;
+}
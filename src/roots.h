@@ -0,0 +1,97 @@
+#ifndef __BIGNUM_ROOTS__
+#define __BIGNUM_ROOTS__
+
+#include <stdexcept>
+#include <boost/multiprecision/cpp_int.hpp>
+#include "biginteger_vector.h"
+
+/*
+ * Exact integer roots, computed by Newton's method on the integers.
+ *
+ * Starting from a power of two at least as large as the root, the iterates
+ * decrease monotonically until they reach floor(x^(1/n)), so the loop stops
+ * at the first step that doesn't decrease.
+ */
+
+// floor(x^(1/n)) for x >= 0 and n >= 1
+inline biginteger_type integer_root_magnitude(const biginteger_type &x, unsigned n) {
+  if (x < 2 || n == 1) {
+    return x;
+  }
+
+  const unsigned bits = boost::multiprecision::msb(x) + 1;
+  if (n >= bits) {
+    return 1; // 2^n > x
+  }
+
+  biginteger_type root = biginteger_type(1) << ((bits + n - 1) / n);
+  while (true) {
+    const biginteger_type next = n == 2
+      ? biginteger_type((root + x / root) >> 1)
+      : biginteger_type(((n - 1) * root + x / boost::multiprecision::pow(root, n - 1)) / n);
+    if (next >= root) {
+      return root;
+    }
+    root = next;
+  }
+}
+
+// Truncated towards zero. Even roots of negative values are undefined.
+inline biginteger_type integer_root(const biginteger_type &x, int n) {
+  if (n < 1) {
+    throw std::domain_error("root must be positive");
+  }
+  if (x < 0) {
+    if (n % 2 == 0) {
+      throw std::domain_error("even root of negative value");
+    }
+    return -integer_root_magnitude(-x, n);
+  }
+  return integer_root_magnitude(x, n);
+}
+
+inline bool is_square(const biginteger_type &x) {
+  if (x < 0) {
+    return false;
+  }
+
+  // Squares take 12 of the 64 residues modulo 64, so most values stop here
+  const unsigned residue = static_cast<unsigned>(x.backend().limbs()[0] & 63);
+  if (!((0x0202021202030213ULL >> residue) & 1)) {
+    return false;
+  }
+
+  const biginteger_type root = integer_root_magnitude(x, 2);
+  return root * root == x;
+}
+
+// x == a^k for some integer a and k >= 2
+inline bool is_perfect_power(const biginteger_type &x) {
+  if (x == 0 || x == 1 || x == -1) {
+    return true;
+  }
+
+  const biginteger_type magnitude = x < 0 ? biginteger_type(-x) : x;
+  const unsigned bits = boost::multiprecision::msb(magnitude) + 1;
+
+  // Only prime exponents need checking (a^(pq) == (a^p)^q). Negative values
+  // need an odd exponent.
+  if (x > 0 && is_square(x)) {
+    return true;
+  }
+  for (unsigned k=3; k<bits; k+=2) {
+    bool k_is_prime = true;
+    for (unsigned d=3; d * d <= k; d+=2) {
+      if (k % d == 0) {
+        k_is_prime = false;
+        break;
+      }
+    }
+    if (k_is_prime && boost::multiprecision::pow(integer_root_magnitude(magnitude, k), k) == magnitude) {
+      return true;
+    }
+  }
+  return false;
+}
+
+#endif
@@ -0,0 +1,62 @@
+#include "sequence.h"
+#include "altrep.h"
+#include "parallel.h"
+
+
+/*---------------------------*
+ *  Computing every element  *
+ *---------------------------*/
+static const std::size_t sequence_block_size = 1024;
+
+biginteger_vector materialize_sequence(const biginteger_sequence &seq) {
+  biginteger_vector output(seq.size);
+
+  // Integer addition is exact, so each block only needs one multiplication
+  parallel_blocks(seq.size, sequence_block_size, [&](std::size_t begin, std::size_t end) {
+    biginteger_type value = seq[begin];
+    for (std::size_t i=begin; i<end; ++i) {
+      output.data[i] = value;
+      value += seq.step;
+    }
+  });
+
+  return output;
+}
+
+bigfloat_vector materialize_sequence(const bigfloat_sequence &seq) {
+  bigfloat_vector output(seq.size);
+
+  // Repeated addition would accumulate rounding errors
+  parallel_blocks(seq.size, sequence_block_size, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i=begin; i<end; ++i) {
+      output.data[i] = seq[i];
+    }
+  });
+
+  return output;
+}
+
+
+/*------------------*
+ *  Returning to R  *
+ *------------------*/
+template<class Seq>
+cpp11::strings encode_sequence_impl(const Seq &seq, const char *cls) {
+#ifdef BIGNUM_ALTREP
+  if (use_lazy_encoding(seq.size)) {
+    cpp11::sexp output(new_sequence_strings(seq));
+    output.attr("class") = {cls, "bignum_vctr", "vctrs_vctr"};
+    return cpp11::strings(output);
+  }
+#endif
+
+  return materialize_sequence(seq).encode();
+}
+
+cpp11::strings encode_sequence(const biginteger_sequence &seq) {
+  return encode_sequence_impl(seq, "bignum_biginteger");
+}
+
+cpp11::strings encode_sequence(const bigfloat_sequence &seq) {
+  return encode_sequence_impl(seq, "bignum_bigfloat");
+}
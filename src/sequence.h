@@ -0,0 +1,48 @@
+#ifndef __BIGNUM_SEQUENCE__
+#define __BIGNUM_SEQUENCE__
+
+#include <cstddef>
+#include "biginteger_vector.h"
+#include "bigfloat_vector.h"
+
+/*
+ * Arithmetic sequence: start + step * i, for i in [0, size).
+ *
+ * Large sequences are returned to R in compact form (see altrep.h), so the
+ * length and range (and the sum of biginteger sequences) are known without
+ * visiting the elements.
+ */
+template<class T>
+struct arithmetic_sequence {
+  arithmetic_sequence(const T &start, const T &step, std::size_t size)
+    : start(start), step(step), size(size) {}
+
+  T start;
+  T step;
+  std::size_t size;
+
+  T operator[](std::size_t i) const { return start + step * i; }
+
+  T min() const { return step < 0 ? (*this)[size - 1] : start; }
+  T max() const { return step < 0 ? start : (*this)[size - 1]; }
+
+  // n * start + step * n(n-1)/2 (exact for biginteger only; bigfloat sums
+  // add up the elements, which rounds differently)
+  T sum() const {
+    const T n(size);
+    return n * start + step * (n * (n - 1) / 2);
+  }
+};
+
+typedef arithmetic_sequence<biginteger_type> biginteger_sequence;
+typedef arithmetic_sequence<bigfloat_type> bigfloat_sequence;
+
+// Computes every element, in parallel
+biginteger_vector materialize_sequence(const biginteger_sequence &seq);
+bigfloat_vector materialize_sequence(const bigfloat_sequence &seq);
+
+// Returns a sequence to R (compact if large)
+cpp11::strings encode_sequence(const biginteger_sequence &seq);
+cpp11::strings encode_sequence(const bigfloat_sequence &seq);
+
+#endif
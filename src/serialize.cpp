@@ -0,0 +1,346 @@
+#include <cstring>
+#include <fstream>
+#include <cpp11.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include "biginteger_vector.h"
+#include "bigfloat_vector.h"
+#include "interrupt.h"
+
+namespace mp = boost::multiprecision;
+namespace ip = boost::interprocess;
+
+/*
+ * Binary file layout (all integers little-endian, sections 8-byte aligned):
+ *
+ *   header      magic "BIGNUM", uint16 version, uint8 type, uint8 reserved,
+ *               uint64 size (n)
+ *   na          bitmap of n bits
+ *
+ * biginteger (type 1):
+ *   sign        bitmap of n bits (set if negative)
+ *   offsets     uint64[n + 1] byte offsets into the limb pool
+ *   limbs       magnitudes as little-endian bytes, packed back to back
+ *
+ * bigfloat (type 2), one fixed-width record per element in separate planes:
+ *   exponent    int32[n] binary exponent of the normalized mantissa
+ *   flags       uint8[n] class (0 zero, 1 normal, 2 infinity, 3 NaN) | sign << 7
+ *   mantissa    n x 21 bytes, little-endian 168-bit mantissa
+ */
+
+static const char bignum_magic[6] = {'B', 'I', 'G', 'N', 'U', 'M'};
+static const uint16_t bignum_format_version = 1;
+static const std::size_t header_size = 16;
+
+enum bignum_file_type {
+  bignum_file_biginteger = 1,
+  bignum_file_bigfloat = 2
+};
+
+typedef bigfloat_type::backend_type bigfloat_backend;
+typedef mp::number<bigfloat_backend::rep_type> bigfloat_mantissa;
+static const std::size_t mantissa_bytes = bigfloat_backend::bit_count / 8;
+
+
+/*-----------*
+ *  Writing  *
+ *-----------*/
+class binary_writer {
+public:
+  binary_writer(const std::string &path) : file(path.c_str(), std::ios::binary) {
+    if (!file) {
+      cpp11::stop("Can't open file '%s' for writing.", path.c_str());
+    }
+  }
+
+  void write_bytes(const void *data, std::size_t size) {
+    file.write(static_cast<const char*>(data), size);
+    written += size;
+  }
+
+  void write_uint(uint64_t value, std::size_t size) {
+    unsigned char buf[8];
+    for (std::size_t i=0; i<size; ++i) {
+      buf[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+    write_bytes(buf, size);
+  }
+
+  void write_bitmap(const std::vector<bool> &bits) {
+    std::vector<unsigned char> buf((bits.size() + 7) / 8);
+    for (std::size_t i=0; i<bits.size(); ++i) {
+      if (bits[i]) buf[i / 8] |= 1 << (i % 8);
+    }
+    write_bytes(buf.data(), buf.size());
+    align();
+  }
+
+  void align() {
+    static const char zeros[8] = {0};
+    write_bytes(zeros, (8 - written % 8) % 8);
+  }
+
+  void write_header(bignum_file_type type, std::size_t size) {
+    write_bytes(bignum_magic, sizeof(bignum_magic));
+    write_uint(bignum_format_version, 2);
+    write_uint(type, 1);
+    write_uint(0, 1);
+    write_uint(size, 8);
+  }
+
+  void close() {
+    file.close();
+    if (!file) {
+      cpp11::stop("Failed to write file."); // # nocov
+    }
+  }
+
+private:
+  std::ofstream file;
+  std::size_t written = 0;
+};
+
+[[cpp11::register]]
+void c_biginteger_write(cpp11::strings x, cpp11::strings path) {
+  biginteger_vector input(x);
+  const std::size_t n = input.size();
+
+  std::vector<bool> negative(n);
+  std::vector<std::vector<unsigned char> > magnitudes(n);
+  for (interrupt_blocks block(n); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (!input.is_na[i]) {
+        negative[i] = input.data[i] < 0;
+        mp::export_bits(biginteger_type(mp::abs(input.data[i])), std::back_inserter(magnitudes[i]), 8, false);
+      }
+    }
+  }
+
+  binary_writer writer(path[0]);
+  writer.write_header(bignum_file_biginteger, n);
+  writer.write_bitmap(input.is_na);
+  writer.write_bitmap(negative);
+
+  uint64_t offset = 0;
+  writer.write_uint(offset, 8);
+  for (std::size_t i=0; i<n; ++i) {
+    offset += magnitudes[i].size();
+    writer.write_uint(offset, 8);
+  }
+  for (std::size_t i=0; i<n; ++i) {
+    writer.write_bytes(magnitudes[i].data(), magnitudes[i].size());
+  }
+  writer.align();
+  writer.close();
+}
+
+[[cpp11::register]]
+void c_bigfloat_write(cpp11::strings x, cpp11::strings path) {
+  bigfloat_vector input(x);
+  const std::size_t n = input.size();
+
+  std::vector<unsigned char> flags(n);
+  std::vector<unsigned char> mantissas(n * mantissa_bytes);
+
+  binary_writer writer(path[0]);
+  writer.write_header(bignum_file_bigfloat, n);
+  writer.write_bitmap(input.is_na);
+
+  for (interrupt_blocks block(n); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      const bigfloat_backend &value = input.data[i].backend();
+      const int32_t exponent = value.exponent();
+      writer.write_uint(static_cast<uint32_t>(exponent), 4);
+
+      unsigned char cls;
+      switch (exponent) {
+      case bigfloat_backend::exponent_zero: cls = 0; break;
+      case bigfloat_backend::exponent_infinity: cls = 2; break;
+      case bigfloat_backend::exponent_nan: cls = 3; break;
+      default: cls = 1;
+      }
+      flags[i] = cls | (value.sign() ? 0x80 : 0);
+
+      if (cls == 1) {
+        unsigned char *out = &mantissas[i * mantissa_bytes];
+        mp::export_bits(bigfloat_mantissa(value.bits()), out, 8, false);
+      }
+    }
+  }
+  writer.align();
+  writer.write_bytes(flags.data(), n);
+  writer.align();
+  writer.write_bytes(mantissas.data(), mantissas.size());
+  writer.align();
+  writer.close();
+}
+
+
+/*-----------*
+ *  Reading  *
+ *-----------*/
+class binary_reader {
+public:
+  binary_reader(const char *data, std::size_t size) : data(data), size(size), pos(0) {}
+
+  const char* take(std::size_t n) {
+    if (n > size - pos) {
+      cpp11::stop("File is truncated or corrupt.");
+    }
+    const char *out = data + pos;
+    pos += n;
+    return out;
+  }
+
+  uint64_t read_uint(std::size_t n) {
+    const unsigned char *buf = reinterpret_cast<const unsigned char*>(take(n));
+    uint64_t value = 0;
+    for (std::size_t i=0; i<n; ++i) {
+      value |= static_cast<uint64_t>(buf[i]) << (8 * i);
+    }
+    return value;
+  }
+
+  std::vector<bool> read_bitmap(std::size_t n) {
+    const unsigned char *buf = reinterpret_cast<const unsigned char*>(take((n + 7) / 8));
+    std::vector<bool> bits(n);
+    for (std::size_t i=0; i<n; ++i) {
+      bits[i] = (buf[i / 8] >> (i % 8)) & 1;
+    }
+    align();
+    return bits;
+  }
+
+  void align() {
+    take((8 - pos % 8) % 8);
+  }
+
+private:
+  const char *data;
+  std::size_t size;
+  std::size_t pos;
+};
+
+cpp11::strings read_biginteger(binary_reader &reader, std::size_t n) {
+  biginteger_vector output(n);
+  output.is_na = reader.read_bitmap(n);
+  std::vector<bool> negative = reader.read_bitmap(n);
+
+  std::vector<uint64_t> offsets(n + 1);
+  for (std::size_t i=0; i<=n; ++i) {
+    offsets[i] = reader.read_uint(8);
+    if (i > 0 && offsets[i] < offsets[i-1]) {
+      cpp11::stop("File is truncated or corrupt.");
+    }
+  }
+
+  const unsigned char *limbs = reinterpret_cast<const unsigned char*>(reader.take(offsets[n]));
+  for (interrupt_blocks block(n); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (!output.is_na[i]) {
+        mp::import_bits(output.data[i], limbs + offsets[i], limbs + offsets[i+1], 8, false);
+        if (negative[i]) {
+          output.data[i] = -output.data[i];
+        }
+      }
+    }
+  }
+
+  return output.encode();
+}
+
+cpp11::strings read_bigfloat(binary_reader &reader, std::size_t n) {
+  bigfloat_vector output(n);
+  output.is_na = reader.read_bitmap(n);
+
+  const char *exponents = reader.take(4 * n);
+  reader.align();
+  const unsigned char *flags = reinterpret_cast<const unsigned char*>(reader.take(n));
+  reader.align();
+  const unsigned char *mantissas = reinterpret_cast<const unsigned char*>(reader.take(n * mantissa_bytes));
+
+  bigfloat_mantissa mantissa;
+  for (interrupt_blocks block(n); block.next(); ) {
+    for (std::size_t i=block.begin(); i<block.end(); ++i) {
+      if (output.is_na[i]) {
+        continue;
+      }
+
+      binary_reader exponent(exponents + 4 * i, 4);
+      bigfloat_backend &value = output.data[i].backend();
+
+      switch (flags[i] & 0x7f) {
+      case 0:
+        value.exponent() = bigfloat_backend::exponent_zero;
+        break;
+      case 1:
+        mp::import_bits(mantissa, mantissas + i * mantissa_bytes, mantissas + (i + 1) * mantissa_bytes, 8, false);
+        if (mantissa == 0 || mp::msb(mantissa) != bigfloat_backend::bit_count - 1) {
+          cpp11::stop("File is truncated or corrupt.");
+        }
+        value.bits() = mantissa.backend();
+        value.exponent() = static_cast<int32_t>(static_cast<uint32_t>(exponent.read_uint(4)));
+        break;
+      case 2:
+        value.exponent() = bigfloat_backend::exponent_infinity;
+        break;
+      case 3:
+        value.exponent() = bigfloat_backend::exponent_nan;
+        break;
+      default:
+        cpp11::stop("File is truncated or corrupt.");
+      }
+      value.sign() = (flags[i] & 0x80) != 0;
+    }
+  }
+
+  return output.encode();
+}
+
+cpp11::strings read_bignum_buffer(const char *data, std::size_t size) {
+  binary_reader reader(data, size);
+
+  if (size < header_size || std::memcmp(reader.take(sizeof(bignum_magic)), bignum_magic, sizeof(bignum_magic)) != 0) {
+    cpp11::stop("File is not a bignum binary file.");
+  }
+  if (reader.read_uint(2) > bignum_format_version) {
+    cpp11::stop("File was written by a newer version of bignum.");
+  }
+  const uint64_t type = reader.read_uint(1);
+  reader.read_uint(1);
+  const std::size_t n = reader.read_uint(8);
+  if (n > 8 * size) {
+    cpp11::stop("File is truncated or corrupt.");
+  }
+
+  switch (type) {
+  case bignum_file_biginteger:
+    return read_biginteger(reader, n);
+  case bignum_file_bigfloat:
+    return read_bigfloat(reader, n);
+  default:
+    cpp11::stop("File is truncated or corrupt.");
+  }
+}
+
+[[cpp11::register]]
+cpp11::strings c_bignum_read(cpp11::strings path, bool mmap) {
+  const std::string filename(path[0]);
+
+  std::ifstream file(filename.c_str(), std::ios::binary | std::ios::ate);
+  if (!file) {
+    cpp11::stop("Can't open file '%s'.", filename.c_str());
+  }
+  const std::size_t size = static_cast<std::size_t>(file.tellg());
+
+  if (mmap && size > 0) {
+    ip::file_mapping mapping(filename.c_str(), ip::read_only);
+    ip::mapped_region region(mapping, ip::read_only);
+    return read_bignum_buffer(static_cast<const char*>(region.get_address()), region.get_size());
+  }
+
+  std::vector<char> buffer(size);
+  file.seekg(0);
+  file.read(buffer.data(), size);
+  return read_bignum_buffer(buffer.data(), size);
+}
@@ -0,0 +1,204 @@
+#ifndef __BIGNUM_SUMMARY__
+#define __BIGNUM_SUMMARY__
+
+#include <vector>
+#include "biginteger_vector.h"
+#include "bigfloat_vector.h"
+#include "multiply.h"
+#include "parallel.h"
+
+/*
+ * Summary statistics (count, sum, product, min, max, mean and variance) in a
+ * single pass over the elements. Only the requested fields are computed, so
+ * e.g. range() doesn't add up the values; the count and missing values are
+ * always tracked.
+ *
+ * Blocks of elements are summarised in parallel, then merged in order, so
+ * results don't depend on the number of threads. The variance uses Welford's
+ * update within a block and Chan's formula to merge blocks, which avoids the
+ * cancellation in sum(x^2) - n * mean^2.
+ */
+enum summary_field {
+  summary_extrema = 1,
+  summary_sum = 2,
+  summary_product = 4,
+  summary_moments = 8,
+  summary_all = summary_extrema | summary_sum | summary_moments
+};
+
+inline biginteger_type summary_multiply(const biginteger_type &a, const biginteger_type &b) {
+  return fast_multiply(a, b);
+}
+
+inline bigfloat_type summary_multiply(const bigfloat_type &a, const bigfloat_type &b) {
+  return a * b;
+}
+
+template<class T>
+struct summary_statistics {
+  summary_statistics() : count(0), has_na(false), sum(0), product(1), min(0), max(0), mean(0), m2(0) {}
+
+  std::size_t count;
+  bool has_na;
+  T sum;
+  T product;
+  T min;
+  T max;
+
+  // Running mean and sum of squared deviations (only with summary_moments)
+  bigfloat_type mean;
+  bigfloat_type m2;
+
+  void update(const T &x, int fields) {
+    if (fields & summary_extrema) {
+      if (count == 0 || x < min) {
+        min = x;
+      }
+      if (count == 0 || x > max) {
+        max = x;
+      }
+    }
+    ++count;
+    if (fields & summary_sum) {
+      sum += x;
+    }
+    if (fields & summary_product) {
+      product = summary_multiply(product, x);
+    }
+
+    if (fields & summary_moments) {
+      const bigfloat_type value(x);
+      const bigfloat_type delta = value - mean;
+      mean += delta / count;
+      m2 += delta * (value - mean);
+    }
+  }
+
+  void merge(const summary_statistics &other, int fields) {
+    has_na = has_na || other.has_na;
+    if (other.count == 0) {
+      return;
+    }
+    if (fields & summary_extrema) {
+      if (count == 0 || other.min < min) {
+        min = other.min;
+      }
+      if (count == 0 || other.max > max) {
+        max = other.max;
+      }
+    }
+
+    if (fields & summary_moments) {
+      const bigfloat_type n_lhs(count), n_rhs(other.count), n(count + other.count);
+      const bigfloat_type delta = other.mean - mean;
+      mean += delta * n_rhs / n;
+      m2 += other.m2 + delta * delta * n_lhs * n_rhs / n;
+    }
+
+    count += other.count;
+    if (fields & summary_sum) {
+      sum += other.sum;
+    }
+    if (fields & summary_product) {
+      product = summary_multiply(product, other.product);
+    }
+  }
+
+  // Sample variance (needs two elements)
+  bigfloat_type variance() const {
+    return m2 / (count - 1);
+  }
+};
+
+inline bool is_missing_value(const biginteger_type &x) { return false; }
+inline bool is_missing_value(const bigfloat_type &x) { return boost::multiprecision::isnan(x); }
+
+// Without `na_rm`, stops at the first missing value and sets `has_na`
+template<class T>
+summary_statistics<T> summarise(const std::vector<T> &data, const std::vector<bool> &is_na,
+                                bool na_rm, int fields) {
+  // parallel_blocks() splits the elements at multiples of the block size
+  const std::size_t block_size = 1024;
+  std::vector<summary_statistics<T> > blocks((data.size() + block_size - 1) / block_size);
+
+  parallel_blocks(data.size(), block_size, [&](std::size_t begin, std::size_t end) {
+    summary_statistics<T> &block = blocks[begin / block_size];
+
+    for (std::size_t i=begin; i<end; ++i) {
+      if (is_na[i] || is_missing_value(data[i])) {
+        if (na_rm) {
+          continue;
+        }
+        block.has_na = true;
+        break;
+      }
+      block.update(data[i], fields);
+    }
+  });
+
+  summary_statistics<T> output;
+  for (std::size_t b=0; b<blocks.size(); ++b) {
+    output.merge(blocks[b], fields);
+  }
+  return output;
+}
+
+
+/*------------------*
+ *  Returning to R  *
+ *------------------*/
+// NULL when there are no elements, so the caller can use its own default
+template<class Vec, class T>
+SEXP summary_range(const summary_statistics<T> &stats) {
+  if (stats.has_na) {
+    return Vec(2, 0, true).encode();
+  }
+  if (stats.count == 0) {
+    return R_NilValue;
+  }
+
+  Vec output(2);
+  output.data[0] = stats.min;
+  output.data[1] = stats.max;
+  return output.encode();
+}
+
+// NaN when there are no elements, like base R
+template<class T>
+bigfloat_vector summary_mean(const summary_statistics<T> &stats) {
+  if (stats.has_na) {
+    return bigfloat_vector(1, 0, true);
+  }
+  return bigfloat_vector(1, bigfloat_type(stats.sum) / stats.count);
+}
+
+template<class T>
+bigfloat_vector summary_variance(const summary_statistics<T> &stats) {
+  if (stats.has_na || stats.count < 2) {
+    return bigfloat_vector(1, 0, true);
+  }
+  return bigfloat_vector(1, stats.variance());
+}
+
+template<class Vec, class T>
+cpp11::list summary_list(const summary_statistics<T> &stats) {
+  using namespace cpp11::literals;
+
+  const bool na_extrema = stats.has_na || stats.count == 0;
+  bigfloat_vector sd = summary_variance(stats);
+  if (!sd.is_na[0]) {
+    sd.data[0] = boost::multiprecision::sqrt(sd.data[0]);
+  }
+
+  return cpp11::writable::list({
+    "n"_nm = stats.has_na ? NA_REAL : static_cast<double>(stats.count),
+    "sum"_nm = Vec(1, stats.sum, stats.has_na).encode(),
+    "mean"_nm = summary_mean(stats).encode(),
+    "var"_nm = summary_variance(stats).encode(),
+    "sd"_nm = sd.encode(),
+    "min"_nm = Vec(1, stats.min, na_extrema).encode(),
+    "max"_nm = Vec(1, stats.max, na_extrema).encode()
+  });
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef __BIGNUM_TRIGONOMETRY__
+#define __BIGNUM_TRIGONOMETRY__
+
+#include <limits>
+#include <boost/math/constants/constants.hpp>
+#include "bigfloat_vector.h"
+
+/*
+ * cos(pi * x), sin(pi * x) and tan(pi * x).
+ *
+ * The argument is reduced by the period before multiplying by pi. Reducing
+ * modulo a power of two is exact in binary, so large arguments keep their
+ * accuracy, and multiples of 1/4 give exact results. The reduced argument is
+ * then folded into [0, 1/4], where the series converge fastest.
+ */
+
+inline bigfloat_type pi_times(const bigfloat_type &x) {
+  return boost::math::constants::pi<bigfloat_type>() * x;
+}
+
+// sin(pi * x) for x in [0, 1/2]
+inline bigfloat_type sin_pi_quadrant(const bigfloat_type &x) {
+  if (x == 0) {
+    return 0;
+  }
+  return x > 0.25 ? boost::multiprecision::cos(pi_times(0.5 - x)) : boost::multiprecision::sin(pi_times(x));
+}
+
+inline bigfloat_type cos_pi(const bigfloat_type &x) {
+  if (!boost::multiprecision::isfinite(x)) {
+    return std::numeric_limits<bigfloat_type>::quiet_NaN();
+  }
+
+  // Even with period 2, so reduce to [0, 1]
+  bigfloat_type r = boost::multiprecision::abs(boost::multiprecision::fmod(x, 2));
+  if (r > 1) {
+    r = 2 - r;
+  }
+
+  // cos(pi * r) == sin(pi * (1/2 - r))
+  if (r == 0.5) {
+    return 0;
+  }
+  return r > 0.5 ? bigfloat_type(-sin_pi_quadrant(r - 0.5)) : sin_pi_quadrant(0.5 - r);
+}
+
+inline bigfloat_type sin_pi(const bigfloat_type &x) {
+  if (!boost::multiprecision::isfinite(x)) {
+    return std::numeric_limits<bigfloat_type>::quiet_NaN();
+  }
+
+  // Odd with period 2, so reduce to [0, 1] and keep the sign
+  bigfloat_type r = boost::multiprecision::fmod(x, 2);
+  if (r <= -1) {
+    r += 2;
+  } else if (r > 1) {
+    r -= 2;
+  }
+  const bool negative = r < 0;
+  r = boost::multiprecision::abs(r);
+  if (r > 0.5) {
+    r = 1 - r;
+  }
+
+  const bigfloat_type output = sin_pi_quadrant(r);
+  return negative && output != 0 ? bigfloat_type(-output) : output;
+}
+
+inline bigfloat_type tan_pi(const bigfloat_type &x) {
+  if (!boost::multiprecision::isfinite(x)) {
+    return std::numeric_limits<bigfloat_type>::quiet_NaN();
+  }
+
+  // Period 1, so reduce to (-1/2, 1/2]
+  bigfloat_type r = boost::multiprecision::fmod(x, 1);
+  if (r <= -0.5) {
+    r += 1;
+  } else if (r > 0.5) {
+    r -= 1;
+  }
+
+  if (r == 0) {
+    return 0;
+  }
+  if (r == 0.5) {
+    return std::numeric_limits<bigfloat_type>::quiet_NaN();
+  }
+  if (r == 0.25 || r == -0.25) {
+    return r > 0 ? 1 : -1;
+  }
+  return boost::multiprecision::tan(pi_times(r));
+}
+
+#endif